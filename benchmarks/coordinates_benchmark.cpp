@@ -0,0 +1,130 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "../src/board.h"
+#include "../src/searcharena.h"
+#include "../src/utility.h"
+
+/**
+ * @brief Compares the coordinate ranges against the vectors they replaced, in time and allocations
+ *
+ * Every allocation in the program is counted through a replaced operator new.
+ * The old functions are copied here as they were.
+ */
+
+namespace {
+    long allocations = 0;
+}
+
+void* operator new(std::size_t size){
+    allocations++;
+    if (void* memory = std::malloc(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {std::free(memory);}
+
+void operator delete(void* memory, std::size_t) noexcept {std::free(memory);}
+
+std::vector<std::pair<int,int>> vectorInRadius(std::pair<int,int> coordinates, int radius){
+    std::vector<std::pair<int,int>> coordinatesInRadius;
+    coordinatesInRadius.reserve(radius*radius);
+    for (int i = coordinates.first - radius; i <= coordinates.first + radius; i++){
+        for (int j = coordinates.second - radius; j <= coordinates.second + radius; j++){
+            coordinatesInRadius.push_back(std::make_pair(i,j));
+        }
+    }
+    return coordinatesInRadius;
+}
+
+std::vector<std::pair<int,int>> vectorInRing(std::pair<int,int> coordinates, int radius){
+    std::vector<std::pair<int,int>> coordinatesInRing;
+    coordinatesInRing.reserve(8*radius);
+    for (int i = coordinates.first - radius; i <= coordinates.first + radius; i++){
+        if (i == coordinates.first - radius || i == coordinates.first + radius){
+            for (int j = coordinates.second - radius; j <= coordinates.second + radius; j++){
+                coordinatesInRing.push_back(std::make_pair(i,j));
+            }
+        }
+        else {
+            coordinatesInRing.push_back(std::make_pair(i, coordinates.second - radius));
+            coordinatesInRing.push_back(std::make_pair(i, coordinates.second + radius));
+        }
+    }
+    return coordinatesInRing;
+}
+
+std::vector<std::pair<int,int>> vectorAdjacent(std::pair<int,int> coordinates){
+    std::vector<std::pair<int,int>> adjacentCoordinates;
+    adjacentCoordinates.reserve(4);
+    adjacentCoordinates.push_back(std::make_pair(coordinates.first-1,coordinates.second));
+    adjacentCoordinates.push_back(std::make_pair(coordinates.first,coordinates.second-1));
+    adjacentCoordinates.push_back(std::make_pair(coordinates.first,coordinates.second+1));
+    adjacentCoordinates.push_back(std::make_pair(coordinates.first+1,coordinates.second));
+    return adjacentCoordinates;
+}
+
+/**
+ * @brief Time a function and count the allocations it makes
+ *
+ * @tparam Function Callable returning a checksum, so the work isn't optimised away
+ * @param name Name to report
+ * @param function Function to run
+ */
+template<class Function>
+void report(const char* name, Function function){
+    long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    long checksum = function();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << name << ms << " ms, " << allocations - before << " allocations (checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char** argv){
+    int calls = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int radius = 10;
+
+    std::cout << calls << " calls each" << std::endl;
+    report("adjacent, vector  ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls; i++) for (auto& here : vectorAdjacent(std::make_pair(i,i))) sum += here.first;
+        return sum;
+    });
+    report("adjacent, array   ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls; i++) for (auto& here : getAdjacentCoordinates(std::make_pair(i,i))) sum += here.first;
+        return sum;
+    });
+    report("radius 10, vector ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls/100; i++) for (auto& here : vectorInRadius(std::make_pair(i,i), radius)) sum += here.second;
+        return sum;
+    });
+    report("radius 10, range  ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls/100; i++) for (auto& here : getCoordinatesInRadius(std::make_pair(i,i), radius)) sum += here.second;
+        return sum;
+    });
+    report("ring 10, vector   ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls/10; i++) for (auto& here : vectorInRing(std::make_pair(i,i), radius)) sum += here.second;
+        return sum;
+    });
+    report("ring 10, range    ", [&]{
+        long sum = 0;
+        for (int i = 0; i < calls/10; i++) for (auto& here : getCoordinatesInRing(std::make_pair(i,i), radius)) sum += here.second;
+        return sum;
+    });
+
+    // A breadth first search expands every node through getAdjacentCoordinates, a warm arena leaves it nothing else to allocate
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 100);
+    SearchArena arena;
+    board.pathTo(arena, std::make_pair(0,0), TileGen::desert, -1, true, 200, 50);
+    report("pathTo 51st desert ", [&]{
+        return long(board.pathTo(arena, std::make_pair(0,0), TileGen::desert, -1, true, 200, 50).tilesTraversed);
+    });
+    return 0;
+}
\ No newline at end of file
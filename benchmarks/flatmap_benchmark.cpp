@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "../src/board.h"
+#include "../src/flatmap.h"
+#include "../src/global.h"
+#include "../src/utility.h"
+
+/**
+ * @brief Compares the flat coordinate maps against the node-based std containers
+ *
+ * Replays the query mix of the board tests (nearby biomes and features with
+ * and without skips, a coordinate target, and searches that never find
+ * anything) as breadth first and cheapest first sweeps over a generated
+ * board. The sweeps are run once with a std::unordered_map as the index of
+ * searched tiles and once with a FlatMap, both cleared and reused between
+ * searches like a SearchArena. Every tile the sweeps look up is recorded and
+ * looked up again through a chunk index kept in a std::unordered_map (as
+ * ChunkMap kept it before) and through the ChunkMap.
+ */
+
+/** One search of the query mix */
+struct Query{
+    /** Biome to look for (-1 to ignore) */
+    int biome;
+    /** Feature to look for (-1 to ignore) */
+    int feature;
+    /** End position (used if both biome and feature are -1) */
+    std::pair<int,int> end;
+    /** Matches to skip */
+    int toSkip;
+    /** Whether or not travel cost is ignored */
+    bool ignoreTravelCost;
+    /** Longest distance searched */
+    int maxDistance;
+};
+
+/** The search index the way a node-based map provides it */
+struct StdIndex{
+    std::unordered_map<std::pair<int,int>, int, CoordinateHash> map;
+
+    std::pair<int*,bool> insert(std::pair<int,int> coordinates, int value){
+        auto [entry, inserted] = map.try_emplace(coordinates, value);
+        return std::make_pair(&entry->second, inserted);
+    }
+
+    void clear(){map.clear();}
+};
+
+/** The chunk index ChunkMap kept before, one node per chunk */
+struct StdChunks{
+    std::unordered_map<std::pair<int,int>, Chunk, CoordinateHash> chunks;
+
+    const Tile* find(std::pair<int,int> coordinates) const {
+        auto chunk = chunks.find(ChunkMap::chunkCoordinates(coordinates));
+        if (chunk == chunks.end()) return nullptr;
+        int index = ChunkMap::localIndex(coordinates);
+        return chunk->second.contains(index) ? &chunk->second.tiles[index] : nullptr;
+    }
+};
+
+struct Node{
+    std::pair<int,int> coordinates;
+    int tilesTraversed;
+    int travelCost;
+};
+
+bool matches(const Tile& tile, std::pair<int,int> here, const Query& query){
+    if (query.feature != -1) return tile.getFeature() == query.feature || (query.feature == featGen.any && tile.getFeature() != featGen.none);
+    if (query.biome != -1) return tile.getBiome() == query.biome;
+    return here == query.end;
+}
+
+/**
+ * @brief Sweep out from the start like Board::pathTo until a query is answered
+ *
+ * @return Travel cost to the match (-1 if there was none)
+ */
+template<class Index>
+int sweep(const ChunkMap& tiles, Index& index, std::vector<Node>& nodes, std::vector<std::pair<int,int>>& lookups, const Query& query){
+    index.clear();
+    nodes.clear();
+    std::vector<std::tuple<int,int>> heap;
+    std::size_t head = 0;
+    int matched = 0;
+    auto find = [&](std::pair<int,int> here){
+        lookups.push_back(here);
+        return tiles.find(here);
+    };
+
+    index.insert(std::make_pair(0,0), 0);
+    nodes.push_back(Node{std::make_pair(0,0), 0, 0});
+    heap.emplace_back(0, 0);
+    while (query.ignoreTravelCost ? head < nodes.size() : !heap.empty()){
+        int previous;
+        if (query.ignoreTravelCost) previous = head++;
+        else {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<std::tuple<int,int>>());
+            auto [cost, node] = heap.back();
+            heap.pop_back();
+            if (cost != nodes[node].travelCost) continue;
+            previous = node;
+        }
+        Node current = nodes[previous];
+        if (query.ignoreTravelCost && current.tilesTraversed + 1 > query.maxDistance) continue;
+
+        for (auto& here : getAdjacentCoordinates(current.coordinates)){
+            const Tile* tile = find(here);
+            if (tile == nullptr) continue;
+            Node node{here, current.tilesTraversed + 1, current.travelCost + tile->getTravelCost()};
+            if (!query.ignoreTravelCost && node.travelCost > query.maxDistance) continue;
+
+            auto [position, inserted] = index.insert(here, nodes.size());
+            if (!inserted){
+                if (query.ignoreTravelCost || *position == 0 || node.travelCost >= nodes[*position].travelCost) continue;
+                nodes[*position] = node;
+            }
+            else nodes.push_back(node);
+
+            if (query.ignoreTravelCost){
+                if (matches(*tile, here, query) && ++matched > query.toSkip) return node.travelCost;
+            }
+            else {
+                heap.emplace_back(node.travelCost, *position);
+                std::push_heap(heap.begin(), heap.end(), std::greater<std::tuple<int,int>>());
+            }
+        }
+        if (!query.ignoreTravelCost && previous != 0 && matches(*find(current.coordinates), current.coordinates, query) && ++matched > query.toSkip) return current.travelCost;
+    }
+    return -1;
+}
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv){
+    int rounds = argc > 1 ? std::stoi(argv[1]) : 20;
+
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 120);
+    ChunkMap tiles;
+    StdChunks stdChunks;
+    board.forEachChunk([&](std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+        tiles.insertChunk(chunkCoordinates, chunk);
+        stdChunks.chunks.emplace(chunkCoordinates, chunk);
+    });
+
+    std::vector<Query> queries;
+    for (bool ignoreTravelCost : {true, false}){
+        int maxDistance = ignoreTravelCost ? 25 : 1000;
+        for (int toSkip = 0; toSkip < 5; toSkip++) queries.push_back(Query{tileGen.plains, -1, {}, toSkip, ignoreTravelCost, maxDistance});
+        queries.push_back(Query{tileGen.mountains, -1, {}, 0, ignoreTravelCost, maxDistance});
+        for (int toSkip = 0; toSkip < 3; toSkip++) queries.push_back(Query{-1, featGen.any, {}, toSkip, ignoreTravelCost, maxDistance});
+        queries.push_back(Query{-1, featGen.lake, {}, 0, ignoreTravelCost, maxDistance});
+        queries.push_back(Query{tileGen.desert, featGen.camp, {}, 0, ignoreTravelCost, maxDistance});
+        queries.push_back(Query{-1, -1, std::make_pair(3,5), 0, ignoreTravelCost, maxDistance});
+        // Never found, so the whole distance is searched
+        queries.push_back(Query{-1, -1, std::make_pair(100000,0), 0, ignoreTravelCost, ignoreTravelCost ? 100 : maxDistance});
+    }
+
+    std::vector<Node> nodes;
+    std::vector<std::pair<int,int>> lookups;
+    StdIndex stdIndex;
+    FlatMap<int> flatIndex;
+    long stdChecksum = 0;
+    long flatChecksum = 0;
+    double stdMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++){
+            for (auto& query : queries) stdChecksum += sweep(tiles, stdIndex, nodes, lookups, query);
+        }
+    });
+    std::size_t searched = lookups.size();
+    lookups.clear();
+    double flatMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++){
+            for (auto& query : queries) flatChecksum += sweep(tiles, flatIndex, nodes, lookups, query);
+        }
+    });
+
+    long stdHits = 0;
+    long flatHits = 0;
+    double stdChunksMs = timeMs([&]{
+        for (auto& here : lookups){
+            const Tile* tile = stdChunks.find(here);
+            if (tile != nullptr) stdHits += tile->getTravelCost();
+        }
+    });
+    double flatChunksMs = timeMs([&]{
+        for (auto& here : lookups){
+            const Tile* tile = tiles.find(here);
+            if (tile != nullptr) flatHits += tile->getTravelCost();
+        }
+    });
+
+    std::cout << queries.size() << " queries x " << rounds << " rounds, " << searched << " tile lookups" << std::endl;
+    std::cout << "  search index  std::unordered_map " << stdMs << " ms, FlatMap " << flatMs << " ms" << std::endl;
+    std::cout << "  chunk index   std::unordered_map " << stdChunksMs << " ms, ChunkMap " << flatChunksMs << " ms" << std::endl;
+    bool mismatch = stdChecksum != flatChecksum || stdHits != flatHits;
+    if (mismatch) std::cout << "checksum mismatch!" << std::endl;
+    return mismatch;
+}
\ No newline at end of file
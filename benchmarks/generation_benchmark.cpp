@@ -0,0 +1,28 @@
+#include <chrono>
+#include <iostream>
+#include "../src/board.h"
+#include "../src/threadpool.h"
+
+/**
+ * @brief Measures how chunk generation scales with the number of workers
+ *
+ * Pre-generates the same region on a fresh board with 1, 2, 4... workers
+ * up to the number of hardware threads.
+ */
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 1024;
+    int maxThreads = argc > 2 ? std::stoi(argv[2]) : ThreadPool::defaultThreads();
+
+    double serialMs = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2){
+        Board board(7);
+        auto start = std::chrono::steady_clock::now();
+        board.generateRegion(std::make_pair(0,0), radius, threads);
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) serialMs = elapsedMs;
+
+        std::cout << threads << " threads: " << elapsedMs << " ms, speedup " << serialMs/elapsedMs << "x" << std::endl;
+    }
+    return 0;
+}
\ No newline at end of file
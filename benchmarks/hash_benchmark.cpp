@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "../src/chunk.h"
+#include "../src/utility.h"
+
+/**
+ * @brief Compares hashing coordinates with the packed key against the xor of their hashes
+ *
+ * A square around the origin is inserted into an unordered_set and an
+ * unordered_map, the way a search marks tiles visited, then every tile and
+ * as many misses are looked up. The square is symmetric about its diagonal,
+ * which is the worst case for the xor: (x,y) and (y,x) share a hash, and
+ * every (x,x) hashes to 0.
+ */
+
+/** How PairHash hashed coordinates before */
+struct XorPairHash{
+    std::size_t operator()(const std::pair<int,int>& pair) const {
+        return std::hash<int>()(pair.first) ^ std::hash<int>()(pair.second);
+    }
+};
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<class Hash>
+void compare(const std::string& name, int radius){
+    std::unordered_set<std::pair<int,int>, Hash> visited;
+    std::unordered_map<std::pair<int,int>, int, Hash> costs;
+    long found = 0;
+    double insertMs = timeMs([&]{
+        for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), radius)){
+            visited.insert(here);
+            costs.emplace(here, here.first + here.second);
+        }
+    });
+    double lookupMs = timeMs([&]{
+        for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), 2*radius)){
+            found += visited.count(here);
+            auto cost = costs.find(here);
+            if (cost != costs.end()) found += cost->second & 1;
+        }
+    });
+
+    std::size_t longest = 0;
+    std::size_t used = 0;
+    for (std::size_t i = 0; i < visited.bucket_count(); i++){
+        longest = std::max(longest, visited.bucket_size(i));
+        used += visited.bucket_size(i) > 0;
+    }
+    std::cout << "  " << name << "insert " << insertMs << " ms, lookup " << lookupMs << " ms, ";
+    std::cout << double(visited.size())/used << " keys per used bucket, longest " << longest << " (" << found << " found)" << std::endl;
+}
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 150;
+    std::cout << "square of radius " << radius << ", lookups over radius " << 2*radius << std::endl;
+    compare<XorPairHash>("xor of hashes  ", radius);
+    compare<CoordinateHash>("packed key     ", radius);
+    return 0;
+}
\ No newline at end of file
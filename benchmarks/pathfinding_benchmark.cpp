@@ -0,0 +1,294 @@
+#include <chrono>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../src/board.h"
+#include "../src/flowfield.h"
+#include "../src/hierarchy.h"
+#include "../src/pathservice.h"
+#include "../src/global.h"
+#include "../src/utility.h"
+
+/**
+ * @brief Compares A* (findPath) against the BFS pathTo used to run for coordinate queries
+ *
+ * Runs the same random coordinate queries on the test board (if its save
+ * is available) and on a large generated board, then compares separate
+ * pathTo calls against one batched pathsTo sweep for the same targets,
+ * many agents heading to one destination by findPath against a flow field,
+ * long routes by findPath against the chunk hierarchy, a batch of pathTo
+ * queries run one after another against the parallel path service, and
+ * nearest feature searches by pathTo against the feature index.
+ */
+
+/**
+ * @brief The BFS coordinate search pathTo used before findPath, kept for comparison
+ * 
+ */
+Path legacyPathTo(const Board& board, std::pair<int,int> start, int maxDistance, std::pair<int,int> end){
+    std::queue<std::pair<int,int>> queue;
+    std::unordered_set<std::pair<int,int>, PairHash> visited;
+    std::unordered_map<std::pair<int,int>, Path, PairHash> map;
+
+    queue.push(start);
+    visited.insert(start);
+    map.emplace(start, Path());
+
+    while(!queue.empty()){
+        std::pair<int,int> previous = queue.front();
+        queue.pop();
+        if (!board.tileReady(previous)) continue;
+
+        for (auto& here : getAdjacentCoordinates(previous)){
+            if (!visited.count(here)){
+                visited.insert(here);
+                if (!board.tileReady(here)) continue;
+
+                Path path;
+                path.tilesTraversed = map.at(previous).tilesTraversed + 1;
+                path.travelCost = map.at(previous).travelCost + board.getTile(here).getTravelCost();
+                path.steps.push_back(here);
+                if (path.tilesTraversed > maxDistance) break;
+
+                queue.push(here);
+                map.emplace(here, path);
+                if (here == end) return map.at(here);
+            }
+        }
+        map.erase(previous);
+    }
+    Path path;
+    path.tilesTraversed = -1;
+    path.travelCost = -1;
+    return path;
+}
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void compare(const std::string& name, const Board& board, int radius, int queries){
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> distribution(-radius, radius);
+    std::vector<std::pair<int,int>> ends;
+    auto start = std::make_pair(0,0);
+    while ((int)ends.size() < queries){
+        auto end = std::make_pair(distribution(engine), distribution(engine));
+        if (end != start) ends.push_back(end);
+    }
+
+    long legacyTiles = 0;
+    long aStarTiles = 0;
+    double legacyMs = timeMs([&]{
+        for (auto& end : ends) legacyTiles += legacyPathTo(board, start, 2*radius, end).tilesTraversed;
+    });
+    double aStarMs = timeMs([&]{
+        for (auto& end : ends) aStarTiles += board.findPath(start, end, true, 2*radius).tilesTraversed;
+    });
+    double weightedMs = timeMs([&]{
+        for (auto& end : ends) board.findPath(start, end, false, 1000*radius);
+    });
+
+    std::cout << name << " (" << queries << " queries within " << radius << " tiles)" << std::endl;
+    std::cout << "  legacy BFS pathTo     " << legacyMs << " ms" << std::endl;
+    std::cout << "  A* findPath           " << aStarMs << " ms" << std::endl;
+    std::cout << "  A* findPath weighted  " << weightedMs << " ms" << std::endl;
+    if (legacyTiles != aStarTiles) std::cout << "  path length mismatch!" << std::endl;
+}
+
+void compareBatch(const std::string& name, const Board& board, int radius, int matches){
+    auto start = std::make_pair(0,0);
+    std::vector<PathQuery> queries = {
+        PathQuery{-1, featGen.village, start, matches},
+        PathQuery{-1, featGen.city, start, matches},
+        PathQuery{-1, featGen.lake, start, matches},
+        PathQuery{tileGen.desert, -1, start, matches}
+    };
+
+    for (bool ignoreTravelCost : {true, false}){
+        int maxDistance = ignoreTravelCost ? 2*radius : 1000*radius;
+        long separateCost = 0;
+        long batchCost = 0;
+        double separateMs = timeMs([&]{
+            for (auto& query : queries){
+                for (int toSkip = 0; toSkip < query.count; toSkip++){
+                    separateCost += board.pathTo(start, query.biome, query.feature, ignoreTravelCost, maxDistance, toSkip).travelCost;
+                }
+            }
+        });
+        double batchMs = timeMs([&]{
+            auto paths = board.pathsTo(start, queries, ignoreTravelCost, maxDistance);
+            for (std::size_t i = 0; i < queries.size(); i++){
+                for (auto& path : paths[i]) batchCost += path.travelCost;
+                batchCost -= queries[i].count - paths[i].size();
+            }
+        });
+
+        std::cout << name << " (" << queries.size() << " targets, first " << matches << " matches each";
+        std::cout << (ignoreTravelCost ? ", ignoring travel cost)" : ", by travel cost)") << std::endl;
+        std::cout << "  separate pathTo calls " << separateMs << " ms" << std::endl;
+        std::cout << "  batched pathsTo       " << batchMs << " ms" << std::endl;
+        if (separateCost != batchCost) std::cout << "  travel cost mismatch!" << std::endl;
+    }
+}
+
+void compareFlowField(const std::string& name, const Board& board, int radius, int agents){
+    std::mt19937 engine(11);
+    std::uniform_int_distribution<int> distribution(-radius, radius);
+    std::vector<std::pair<int,int>> starts;
+    for (int i = 0; i < agents; i++) starts.push_back(std::make_pair(distribution(engine), distribution(engine)));
+    auto destination = std::make_pair(0,0);
+
+    long findPathCost = 0;
+    long flowFieldCost = 0;
+    double findPathMs = timeMs([&]{
+        for (auto& start : starts) findPathCost += board.findPath(start, destination, false, 1000*radius).travelCost;
+    });
+    double flowFieldMs = timeMs([&]{
+        FlowField field(board, destination, destination, radius + Chunk::size);
+        for (auto& start : starts) flowFieldCost += field.pathFrom(board, start).travelCost;
+    });
+
+    std::cout << name << " (" << agents << " agents heading to one destination within " << radius << " tiles)" << std::endl;
+    std::cout << "  findPath per agent    " << findPathMs << " ms" << std::endl;
+    std::cout << "  flow field            " << flowFieldMs << " ms" << std::endl;
+    if (findPathCost != flowFieldCost) std::cout << "  travel cost mismatch!" << std::endl;
+}
+
+void compareHierarchy(const std::string& name, const Board& board, int radius, int queries){
+    std::mt19937 engine(13);
+    std::uniform_int_distribution<int> distribution(-radius, radius);
+    std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> routes;
+    while ((int)routes.size() < queries){
+        auto start = std::make_pair(distribution(engine), distribution(engine));
+        auto end = std::make_pair(distribution(engine), distribution(engine));
+        if (std::abs(start.first - end.first) + std::abs(start.second - end.second) >= radius) routes.push_back(std::make_pair(start, end));
+    }
+
+    std::vector<int> shortestCosts;
+    std::vector<int> hierarchyCosts;
+    PathHierarchy hierarchy;
+    double findPathMs = timeMs([&]{
+        for (auto& [start, end] : routes) shortestCosts.push_back(board.findPath(start, end, false, 1000*radius).travelCost);
+    });
+    double coldMs = timeMs([&]{
+        for (auto& [start, end] : routes) hierarchyCosts.push_back(hierarchy.findPath(board, start, end).travelCost);
+    });
+    double warmMs = timeMs([&]{
+        for (auto& [start, end] : routes) hierarchy.findPath(board, start, end);
+    });
+
+    long shortestCost = 0;
+    long hierarchyCost = 0;
+    int mismatches = 0;
+    for (std::size_t i = 0; i < routes.size(); i++){
+        if ((shortestCosts[i] == -1) != (hierarchyCosts[i] == -1)) mismatches++;
+        else if (shortestCosts[i] != -1){
+            shortestCost += shortestCosts[i];
+            hierarchyCost += hierarchyCosts[i];
+        }
+    }
+
+    std::cout << name << " (" << queries << " routes of at least " << radius << " tiles)" << std::endl;
+    std::cout << "  A* findPath weighted  " << findPathMs << " ms" << std::endl;
+    std::cout << "  hierarchy, cold       " << coldMs << " ms" << std::endl;
+    std::cout << "  hierarchy, warm       " << warmMs << " ms" << std::endl;
+    std::cout << "  hierarchy cost        " << 100.0*hierarchyCost/std::max(shortestCost, 1L) << "% of shortest" << std::endl;
+    if (mismatches) std::cout << "  " << mismatches << " routes found by only one of them!" << std::endl;
+}
+
+void compareService(const std::string& name, const Board& board, int radius, int queries){
+    std::mt19937 engine(17);
+    std::uniform_int_distribution<int> distribution(-radius, radius);
+    std::vector<PathRequest> requests(queries);
+    for (auto& request : requests){
+        request.start = std::make_pair(distribution(engine), distribution(engine));
+        request.feature = featGen.city;
+        request.ignoreTravelCost = false;
+        request.maxDistance = 1000;
+    }
+
+    long sequentialCost = 0;
+    long serviceCost = 0;
+    double sequentialMs = timeMs([&]{
+        for (auto& request : requests) sequentialCost += PathService::run(board, request).travelCost;
+    });
+    PathService service;
+    std::shared_ptr<const Board> snapshot;
+    double snapshotMs = timeMs([&]{snapshot = PathService::snapshot(board);});
+    int chunks = 0;
+    auto low = ChunkMap::chunkCoordinates(std::make_pair(-radius,-radius));
+    auto high = ChunkMap::chunkCoordinates(std::make_pair(radius,radius));
+    for (int x = low.first; x <= high.first; x++){
+        for (int y = low.second; y <= high.second; y++) chunks += board.getChunk(std::make_pair(x,y)) != nullptr;
+    }
+    double serviceMs = timeMs([&]{
+        for (auto& future : service.submit(snapshot, requests)) serviceCost += future.get().travelCost;
+    });
+
+    std::cout << name << " (" << queries << " pathTo queries)" << std::endl;
+    std::cout << "  one after another     " << sequentialMs << " ms" << std::endl;
+    std::cout << "  taking the snapshot   " << snapshotMs << " ms for " << chunks << " chunks" << std::endl;
+    std::cout << "  path service          " << serviceMs << " ms on " << service.size() << " worker(s)" << std::endl;
+    if (sequentialCost != serviceCost) std::cout << "  travel cost mismatch!" << std::endl;
+}
+
+void compareFeatureIndex(const std::string& name, const Board& board, int radius, int queries){
+    std::mt19937 engine(19);
+    std::uniform_int_distribution<int> distribution(-radius, radius);
+    std::vector<std::pair<int,int>> starts;
+    while ((int)starts.size() < queries) starts.push_back(std::make_pair(distribution(engine), distribution(engine)));
+
+    for (bool ignoreTravelCost : {true, false}){
+        int maxDistance = ignoreTravelCost ? radius : 10*radius;
+        std::vector<int> searchCosts;
+        std::vector<int> indexCosts;
+        double searchMs = timeMs([&]{
+            for (auto& start : starts){
+                Path path = board.pathTo(start, -1, featGen.city, ignoreTravelCost, maxDistance, 0);
+                searchCosts.push_back(ignoreTravelCost ? path.tilesTraversed : path.travelCost);
+            }
+        });
+        double indexMs = timeMs([&]{
+            for (auto& start : starts){
+                Path path = board.pathToFeature(start, featGen.city, ignoreTravelCost, maxDistance);
+                indexCosts.push_back(ignoreTravelCost ? path.tilesTraversed : path.travelCost);
+            }
+        });
+
+        std::cout << name << " (" << queries << " nearest city queries";
+        std::cout << (ignoreTravelCost ? ", ignoring travel cost)" : ", by travel cost)") << std::endl;
+        std::cout << "  pathTo search         " << searchMs << " ms" << std::endl;
+        std::cout << "  feature index + A*    " << indexMs << " ms" << std::endl;
+        if (searchCosts != indexCosts) std::cout << "  path cost mismatch!" << std::endl;
+    }
+}
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 200;
+    int queries = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    try {
+        Board testBoard = load("pathTo", std::make_pair(0,0));
+        compare("tests/pathTo.save", testBoard, testBoard.getViewSize()/2, 10000);
+    }
+    catch (const std::exception&){
+        std::cout << "tests/pathTo.save not available, skipping" << std::endl;
+    }
+
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), radius);
+    compare("generated board", board, radius, queries);
+    compareBatch("generated board", board, radius, 5);
+    compareFlowField("generated board", board, radius, queries);
+    compareHierarchy("generated board", board, radius, queries);
+    compareService("generated board", board, radius, 10*queries);
+    compareFeatureIndex("generated board", board, radius, queries);
+    return 0;
+}
\ No newline at end of file
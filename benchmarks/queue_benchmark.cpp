@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/messagequeue.h"
+
+/**
+ * @brief Compares the lock-free message queues against the mutex queue they replaced
+ *
+ * Producers push short strings (like status rows) as fast as they can while
+ * one consumer pops them, with one producer and then with several.
+ */
+
+/** The mutex and condition variable queue that status rows used before */
+class LockedQueue{
+    std::queue<std::string> queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+public:
+    void push(std::string message){
+        std::lock_guard lock(mutex);
+        queue.push(message);
+        condition.notify_one();
+    }
+
+    std::string pop(){
+        std::unique_lock lock(mutex);
+        condition.wait(lock, [this]{return !queue.empty();});
+        std::string message = queue.front();
+        queue.pop();
+        return message;
+    }
+};
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<class Queue>
+double run(Queue& queue, int producers, int messages){
+    return timeMs([&]{
+        std::vector<std::thread> threads;
+        for (int producer = 0; producer < producers; producer++){
+            threads.emplace_back([&]{for (int i = 0; i < messages; i++) queue.push(std::string("HP: 25"));});
+        }
+        for (int i = 0; i < producers*messages; i++) queue.pop();
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+int main(int argc, char** argv){
+    int messages = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    int producers = std::max(2, int(std::thread::hardware_concurrency()) - 1);
+
+    LockedQueue lockedSingle;
+    SpscQueue<std::string> spsc(1024);
+    LockedQueue lockedMany;
+    MpscQueue<std::string> mpsc(1024);
+    double lockedSingleMs = run(lockedSingle, 1, messages);
+    double spscMs = run(spsc, 1, messages);
+    double lockedManyMs = run(lockedMany, producers, messages);
+    double mpscMs = run(mpsc, producers, messages);
+
+    auto rate = [](int count, double ms){return count/ms/1000;};
+    std::cout << messages << " messages per producer" << std::endl;
+    std::cout << "  1 producer     mutex queue " << rate(messages, lockedSingleMs) << " M/s, ";
+    std::cout << "SPSC queue " << rate(messages, spscMs) << " M/s" << std::endl;
+    std::cout << "  " << producers << " producers    mutex queue " << rate(producers*messages, lockedManyMs) << " M/s, ";
+    std::cout << "MPSC queue " << rate(producers*messages, mpscMs) << " M/s" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <cereal/archives/binary.hpp>
+#include "../src/board.h"
+#include "../src/utility.h"
+#include "../src/worldfile.h"
+
+/**
+ * @brief Compares saving and loading a large world whole with cereal against world files
+ *
+ * The world file is loaded lazily, so its load only pays for the chunks in
+ * view, and paging in a region elsewhere is timed separately. The mapped layout
+ * skips decoding altogether, using chunks in place from the mapping. The chunk
+ * codec is also timed on its own, against the size of the chunks in memory.
+ * Saves only keep the tiles that differ from the generator, so the untouched
+ * world is also written packed in full to show what that saves.
+ */
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 500;
+    auto position = std::make_pair(0,0);
+    Board board(7);
+    board.generateRegion(position, radius);
+
+    double cerealSaveMs = timeMs([&]{
+        std::ofstream ofile("benchmark.cereal.save", std::ios::binary);
+        cereal::BinaryOutputArchive oarchive(ofile);
+        oarchive(board);
+    });
+    double cerealLoadMs = timeMs([&]{
+        Board loaded;
+        std::ifstream ifile("benchmark.cereal.save", std::ios::binary);
+        cereal::BinaryInputArchive iarchive(ifile);
+        iarchive(loaded);
+    });
+
+    double worldSaveMs = timeMs([&]{save(board, "benchmark");});
+    Board loaded = load("benchmark", position);
+    double worldLoadMs = timeMs([&]{loaded = load("benchmark", position);});
+    double worldPageMs = timeMs([&]{loaded.generateRegion(std::make_pair(radius/2, -radius/2), loaded.getViewSize());});
+    double packedSaveMs = timeMs([&]{WorldFile::write(board, "benchmark.packed.save");});
+
+    std::vector<Chunk> chunks;
+    board.forEachChunk([&](std::pair<int,int>, const Chunk& chunk){chunks.push_back(chunk);});
+    std::vector<std::string> blobs(chunks.size());
+    double encodeMs = timeMs([&]{for (std::size_t i = 0; i < chunks.size(); i++) blobs[i] = WorldFile::encode(chunks[i]);});
+    double decodeMs = timeMs([&]{for (std::size_t i = 0; i < chunks.size(); i++) chunks[i] = WorldFile::decode(blobs[i]);});
+    double megabytes = chunks.size()*sizeof(Chunk)/1e6;
+
+    double mappedSaveMs = timeMs([&]{WorldFile::write(board, "benchmark.mapped.save", WorldFile::Layout::mapped);});
+    Board mapped = load("benchmark.mapped", position);
+    double mappedLoadMs = timeMs([&]{mapped = load("benchmark.mapped", position);});
+    double mappedPageMs = timeMs([&]{mapped.generateRegion(std::make_pair(radius/2, -radius/2), mapped.getViewSize());});
+
+    std::cout << "world of " << 2*radius + 1 << "x" << 2*radius + 1 << " tiles" << std::endl;
+    std::cout << "  cereal binary   save " << cerealSaveMs << " ms, load " << cerealLoadMs << " ms, ";
+    std::cout << std::filesystem::file_size("benchmark.cereal.save") << " bytes" << std::endl;
+    std::cout << "  world file      save " << worldSaveMs << " ms, load " << worldLoadMs << " ms, ";
+    std::cout << std::filesystem::file_size("benchmark.save") << " bytes" << std::endl;
+    std::cout << "  world file      page in a view elsewhere " << worldPageMs << " ms" << std::endl;
+    std::cout << "  packed file     save " << packedSaveMs << " ms, ";
+    std::cout << std::filesystem::file_size("benchmark.packed.save") << " bytes" << std::endl;
+    std::cout << "  mapped file     save " << mappedSaveMs << " ms, load " << mappedLoadMs << " ms, ";
+    std::cout << std::filesystem::file_size("benchmark.mapped.save") << " bytes" << std::endl;
+    std::cout << "  mapped file     page in a view elsewhere " << mappedPageMs << " ms" << std::endl;
+    std::cout << "  chunk codec     encode " << megabytes/encodeMs*1000 << " MB/s, decode " << megabytes/decodeMs*1000 << " MB/s" << std::endl;
+
+    std::remove("benchmark.cereal.save");
+    std::remove("benchmark.save");
+    std::remove("benchmark.packed.save");
+    std::remove("benchmark.mapped.save");
+    return 0;
+}
\ No newline at end of file
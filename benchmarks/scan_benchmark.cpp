@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/board.h"
+#include "../src/global.h"
+#include "../src/tilescan.h"
+#include "../src/utility.h"
+
+/**
+ * @brief Compares the region queries on Board against checking tiles one at a time
+ *
+ * On a generated board, finds every forest tile and counts every feature in
+ * a square region, and checks that the region is ready, once tile by tile
+ * through getTile (as regionReady and verify used to) and once through the
+ * chunk scans. Each scan kernel the processor supports is also timed on its
+ * own over every chunk of the region.
+ */
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 500;
+    int rounds = argc > 2 ? std::stoi(argv[2]) : 5;
+    auto center = std::make_pair(0,0);
+
+    Board board(7);
+    board.generateRegion(center, radius);
+
+    long tileFound = 0;
+    long tileFeatures = 0;
+    bool tileReady = true;
+    double tileFindMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++){
+            std::vector<std::pair<int,int>> found;
+            for (auto& here : getCoordinatesInRadius(center, radius)) if (board.getTile(here).getBiome() == tileGen.forest) found.push_back(here);
+            tileFound += found.size();
+        }
+    });
+    double tileCountMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++){
+            for (auto& here : getCoordinatesInRadius(center, radius)) tileFeatures += board.getTile(here).getFeature() != featGen.none;
+        }
+    });
+    double tileReadyMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++){
+            for (auto& here : getCoordinatesInRadius(center, radius)) tileReady = tileReady && board.tileReady(here);
+        }
+    });
+
+    long scanFound = 0;
+    long scanFeatures = 0;
+    bool scanReady = true;
+    double findMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++) scanFound += board.findTiles(center, radius, tileGen.forest, -1).size();
+    });
+    double countMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++) scanFeatures += board.countTiles(center, radius, -1, featGen.any);
+    });
+    double readyMs = timeMs([&]{
+        for (int round = 0; round < rounds; round++) scanReady = scanReady && board.regionReady(center, radius);
+    });
+
+    std::vector<const Chunk*> chunks;
+    auto first = ChunkMap::chunkCoordinates(std::make_pair(center.first - radius, center.second - radius));
+    auto last = ChunkMap::chunkCoordinates(std::make_pair(center.first + radius, center.second + radius));
+    for (int i = first.first; i <= last.first; i++){
+        for (int j = first.second; j <= last.second; j++) chunks.push_back(board.getChunk(std::make_pair(i,j)));
+    }
+
+    std::cout << "square of radius " << radius << ", " << rounds << " rounds" << std::endl;
+    std::cout << "  tile by tile  find " << tileFindMs << " ms, count " << tileCountMs << " ms, ready " << tileReadyMs << " ms" << std::endl;
+    std::cout << "  region scans  find " << findMs << " ms, count " << countMs << " ms, ready " << readyMs << " ms" << std::endl;
+    std::vector<std::pair<ScanKernel, std::string>> kernels = {{ScanKernel::scalar, "scalar"}, {ScanKernel::sse2, "sse2  "}, {ScanKernel::avx2, "avx2  "}};
+    for (auto& [kernel, name] : kernels){
+        if (!scanKernelSupported(kernel)) continue;
+        long matched = 0;
+        double kernelMs = timeMs([&]{
+            for (int round = 0; round < rounds; round++){
+                for (auto chunk : chunks) matched += countMask(scanChunk(*chunk, TilePattern::matching(tileGen.forest, -1), kernel));
+            }
+        });
+        std::cout << "  " << name << " kernel  " << kernelMs << " ms over " << chunks.size() << " chunks (" << matched << " matched)" << std::endl;
+    }
+
+    bool mismatch = tileFound != scanFound || tileFeatures != scanFeatures || tileReady != scanReady;
+    if (mismatch) std::cout << "checksum mismatch!" << std::endl;
+    return mismatch;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+#include "../src/chunk.h"
+
+/**
+ * @brief Compares the chunked tile storage against the std::map it replaced
+ *
+ * Both containers are filled with a square world, then queried with the
+ * same sequence of random lookups (mostly hits, some misses).
+ */
+
+template<class Function>
+double timeMs(Function function){
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv){
+    int radius = argc > 1 ? std::stoi(argv[1]) : 500;
+    int lookups = 10000000;
+
+    std::mt19937 engine(7);
+    std::uniform_int_distribution<int> distribution(-radius - radius/10, radius + radius/10);
+    std::vector<std::pair<int,int>> queries;
+    queries.reserve(lookups);
+    for (int i = 0; i < lookups; i++) queries.push_back(std::make_pair(distribution(engine), distribution(engine)));
+
+    std::map<std::pair<int,int>, Tile> map;
+    ChunkMap chunkMap;
+    long mapHits = 0;
+    long chunkHits = 0;
+
+    double mapInsert = timeMs([&]{
+        for (int i = -radius; i <= radius; i++){
+            for (int j = -radius; j <= radius; j++) map.emplace(std::make_pair(i,j), Tile((i ^ j) & 3));
+        }
+    });
+    double chunkInsert = timeMs([&]{
+        for (int i = -radius; i <= radius; i++){
+            for (int j = -radius; j <= radius; j++) chunkMap.emplace(std::make_pair(i,j), Tile((i ^ j) & 3));
+        }
+    });
+    double mapLookup = timeMs([&]{
+        for (auto& here : queries){
+            auto found = map.find(here);
+            if (found != map.end()) mapHits += found->second.getBiome();
+        }
+    });
+    double chunkLookup = timeMs([&]{
+        for (auto& here : queries){
+            const Tile* found = chunkMap.find(here);
+            if (found != nullptr) chunkHits += found->getBiome();
+        }
+    });
+
+    std::cout << "tiles: " << map.size() << ", lookups: " << lookups << std::endl;
+    std::cout << "std::map  insert " << mapInsert << " ms, lookup " << mapLookup << " ms" << std::endl;
+    std::cout << "ChunkMap  insert " << chunkInsert << " ms, lookup " << chunkLookup << " ms" << std::endl;
+    std::cout << "ChunkMap  " << (double)sizeof(Chunk)/Chunk::area << " bytes per tile in a full chunk (Tile is " << sizeof(Tile) << " byte)" << std::endl;
+    if (mapHits != chunkHits) std::cout << "checksum mismatch!" << std::endl;
+    return mapHits != chunkHits;
+}
\ No newline at end of file
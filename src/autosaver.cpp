@@ -0,0 +1,95 @@
+#include "autosaver.h"
+
+#include <filesystem>
+#include <vector>
+
+Autosaver::Autosaver(Board& board, const std::string& savename, std::chrono::milliseconds interval, int compactAfter)
+    : filename(savename + ".save"), interval(interval), compactAfter(compactAfter){
+    std::shared_ptr<WorldFile> source = board.getSource();
+    std::error_code ignored;
+    if (source == nullptr || !std::filesystem::equivalent(source->getFilename(), filename, ignored)){
+        WorldFile::write(board, filename, WorldFile::Layout::delta);
+        board.takeDirtyChunks();
+    }
+    worker = std::thread(&Autosaver::work, this);
+}
+
+Autosaver::~Autosaver(){
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+void Autosaver::work(){
+    std::unique_lock lock(mutex);
+    while (true){
+        wake.wait_for(lock, interval, [this]{return stopping || flushing;});
+        if (!pending.empty()) writePending(lock);
+        // Chunks snapshotted during the write are written straight away if a flush is waiting
+        if (pending.empty() || error != nullptr) flushing = false;
+        saved.notify_all();
+        if (stopping) return;
+    }
+}
+
+void Autosaver::writePending(std::unique_lock<std::mutex>& lock){
+    std::uint64_t target = taken;
+    std::vector<std::pair<std::pair<int,int>, Chunk>> chunks(pending.begin(), pending.end());
+    pending.clear();
+    lock.unlock();
+
+    std::exception_ptr failure;
+    try {
+        if (file == nullptr) file = std::make_unique<WorldFile>(filename);
+        file->append(chunks);
+        if (++appends >= compactAfter){
+            appends = 0;
+            file.reset();
+            WorldFile::compact(filename);
+            file = std::make_unique<WorldFile>(filename);
+        }
+    }
+    catch (...){
+        failure = std::current_exception();
+    }
+
+    lock.lock();
+    if (failure){
+        error = failure;
+        for (auto& [chunkCoordinates, chunk] : chunks) pending.try_emplace(chunkCoordinates, chunk);
+        return;
+    }
+    written = target;
+}
+
+void Autosaver::snapshot(Board& board){
+    auto chunks = board.takeDirtyChunks();
+    if (chunks.empty()) return;
+    std::lock_guard lock(mutex);
+    for (auto& [chunkCoordinates, chunk] : chunks){
+        // Untouched generated chunks are generated again on load, so they never need saving
+        if (!board.chunkPristine(chunkCoordinates)) pending.insert_or_assign(chunkCoordinates, chunk);
+    }
+    taken++;
+}
+
+void Autosaver::flush(){
+    std::unique_lock lock(mutex);
+    std::uint64_t target = taken;
+    flushing = true;
+    wake.notify_one();
+    saved.wait(lock, [this, target]{return written >= target || error != nullptr;});
+    if (error != nullptr){
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+int Autosaver::pendingChunks(){
+    std::lock_guard lock(mutex);
+    return pending.size();
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef AUTOSAVER
+#define AUTOSAVER
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "board.h"
+#include "worldfile.h"
+
+/**
+ * @brief Saves the chunks that change on a board, on a background thread
+ * 
+ * The thread that owns the board takes snapshots, which copy out only the
+ * chunks changed since the last one and never touch the disk. The background
+ * thread appends them to the world file's journal on an interval, and folds
+ * the journal into the file every so often. Like the Streamer, the background
+ * thread never touches the Board, so the board needs no locking.
+ * 
+ * Chunks that are exactly what the generator makes aren't saved at all, they
+ * are generated again when the save is loaded.
+ * 
+ * Nothing else should write the same save while the autosaver is running.
+ */
+class Autosaver{
+    /** Name of the world file */
+    std::string filename;
+    /** Time between writes */
+    std::chrono::milliseconds interval;
+    /** Number of appends to the journal before it is folded into the file */
+    int compactAfter;
+    /** Appends to the journal since it was last folded in */
+    int appends = 0;
+    /** The world file (only used by the background thread, reopened if a write fails) */
+    std::unique_ptr<WorldFile> file;
+    /** Snapshotted chunks waiting to be written, newest copy of each */
+    std::unordered_map<std::pair<int,int>, Chunk, CoordinateHash> pending;
+    /** Number of snapshots taken */
+    std::uint64_t taken = 0;
+    /** Number of snapshots taken when the last successful write started */
+    std::uint64_t written = 0;
+    /** Why the last write failed (if it did and nobody has been told yet) */
+    std::exception_ptr error;
+    std::mutex mutex;
+    /** Signalled when a flush is wanted or the autosaver stops */
+    std::condition_variable wake;
+    /** Signalled when a write finishes */
+    std::condition_variable saved;
+    bool flushing = false;
+    bool stopping = false;
+    std::thread worker;
+
+    /**
+     * @brief Writes pending chunks on every interval until the autosaver stops
+     * 
+     */
+    void work();
+
+    /**
+     * @brief Write every pending chunk, without holding the lock while writing
+     * 
+     * Must be called with the mutex held. If the write fails, the chunks stay
+     * pending (unless snapshotted again since).
+     * 
+     * @param lock Lock holding the mutex
+     */
+    void writePending(std::unique_lock<std::mutex>& lock);
+
+public:
+    /**
+     * @brief Start saving a board
+     * 
+     * If the board wasn't loaded from this save, the board is written first
+     * (on the calling thread, in the delta layout), so the journal always has a
+     * file under it.
+     * 
+     * @param board Board to save
+     * @param savename Name to save under
+     * @param interval Time between writes
+     * @param compactAfter Number of writes to the journal before it is folded into the file
+     * @throws WorldFileWriteFailed if the board can't be written
+     */
+    Autosaver(Board& board, const std::string& savename, std::chrono::milliseconds interval = std::chrono::seconds(30), int compactAfter = 16);
+
+    /**
+     * @brief Write anything pending, then stop and join the background thread
+     * 
+     * Failures are dropped, call flush first to find out about them.
+     */
+    ~Autosaver();
+
+    Autosaver(const Autosaver&) = delete;
+    Autosaver& operator=(const Autosaver&) = delete;
+
+    /**
+     * @brief Take the chunks changed on the board since the last snapshot
+     * 
+     * Only copies chunks, the write happens later on the background thread.
+     * 
+     * @param board Board being saved
+     */
+    void snapshot(Board& board);
+
+    /**
+     * @brief Block until every snapshot taken so far is written
+     * 
+     * @throws WorldFileWriteFailed if a write failed since the last flush (the chunks are retried on the next write)
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of chunks waiting to be written
+     * 
+     * @return Number of chunks waiting to be written
+     */
+    int pendingChunks();
+};
+
+#endif
\ No newline at end of file
@@ -1,25 +1,33 @@
 #include "board.h"
 
 #include <algorithm>
-#include <queue>
-#include <random>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdlib>
+#include <ctime>
+#include <future>
+#include <limits>
 #include "exceptions.h"
+#include "generator.h"
 #include "global.h"
+#include "searcharena.h"
+#include "threadpool.h"
 #include "utility.h"
+#include "worldfile.h"
 
 Board::Board(){
     seed = time(0);
-    srand(seed);
     generateBoard();
 }
 
 Board::Board(int seed) : seed(seed){
-    srand(seed);
     generateBoard();
 }
 
+Board::Board(Empty) : seed(0){}
+
+Board::Board(std::shared_ptr<WorldFile> source, std::pair<int,int> position) : seed(source->getSeed()), source(source){
+    generateRegion(position, viewSize/2);
+}
+
 Board::~Board(){}
 
 int Board::getViewSize() const {return viewSize;}
@@ -27,189 +35,427 @@ int Board::getViewSize() const {return viewSize;}
 int Board::getSeed() const {return seed;}
 
 Tile Board::getTile(std::pair<int,int> coordinates) const {
-    if (!tileExists(coordinates)) throw TileMissingException();
     return board.at(coordinates);
 }
 
-bool Board::verify(std::pair<int,int> position) const {
-    auto viewableBoard = getCoordinatesInRadius(position, viewSize/2);
-    for (auto& here : viewableBoard) if (!tileExists(here)) return false;
-    return true;
+bool Board::chunkGenerated(std::pair<int,int> chunkCoordinates) const {
+    return board.chunkComplete(chunkCoordinates);
 }
 
-Path Board::pathTo(std::pair<int,int> start, int biome, int feature, bool ignoreTravelCost, int maxDistance, int toSkip, std::pair<int,int> end) const {
-    bool checkBiome = false;
-    bool checkFeature = false;
-    if (biome != -1) checkBiome = true;
-    if (feature != -1) checkFeature = true;
-    
-    std::queue<std::pair<int,int>> queue;
-    std::priority_queue<std::pair<std::pair<int,int>, Path>,std::vector<std::pair<std::pair<int,int>, Path>>,CompareTravelCost> priorityQueue;
-
-    std::unordered_set<std::pair<int,int>, PairHash> visited;
-    std::unordered_map<std::pair<int,int>, Path, PairHash> map;
-
-    if (ignoreTravelCost) queue.push(start);
-    else priorityQueue.push(std::make_pair(start,Path()));
-
-    visited.insert(start);
-    map.emplace(start, Path());
-
-    int matches = 0;
-    while(!queue.empty()){
-        std::pair<int,int> previous;
-        if (ignoreTravelCost){
-            previous = queue.front();
-            queue.pop();
-        } 
-        else {
-            previous = priorityQueue.top().first;
-            priorityQueue.pop();
-        }
+const Chunk* Board::getChunk(std::pair<int,int> chunkCoordinates) const {
+    return board.findChunk(chunkCoordinates);
+}
 
-        if (!tileExists(previous)) continue;
+std::shared_ptr<WorldFile> Board::getSource() const {return source;}
 
-        for (auto& here : getAdjacentCoordinates(previous)){
-            if (!visited.count(here)){
-                visited.insert(here);
+void Board::pageIn(std::pair<int,int> chunkCoordinates){
+    if (source == nullptr || board.findChunk(chunkCoordinates) != nullptr) return;
+    if (source->getLayout() == WorldFile::Layout::mapped){
+        const Chunk* chunk = source->findChunk(chunkCoordinates);
+        if (chunk != nullptr){
+            board.insertView(chunkCoordinates, chunk);
+            indexFeatures(chunkCoordinates);
+        }
+        return;
+    }
+    Chunk chunk;
+    if (source->read(chunkCoordinates, chunk)){
+        board.insertChunk(chunkCoordinates, chunk);
+        indexFeatures(chunkCoordinates);
+    }
+}
 
-                if (!tileExists(here)) continue;
+void Board::indexFeatures(std::pair<int,int> chunkCoordinates){
+    features.update(chunkCoordinates, *board.findChunk(chunkCoordinates));
+}
 
-                Path path;
-                path.tilesTraversed = map.at(previous).tilesTraversed + 1;
-                path.travelCost = map.at(previous).travelCost + getTile(here).getTravelCost();
-                path.steps.push_back(here);
+void Board::addChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+    pageIn(chunkCoordinates);
+    board.insertChunk(chunkCoordinates, chunk);
+    indexFeatures(chunkCoordinates);
+    pristine.erase(chunkCoordinates);
+    dirty.insert(chunkCoordinates);
+}
 
-                if (path.tilesTraversed > maxDistance) break;
+void Board::addGeneratedChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+    pageIn(chunkCoordinates);
+    insertGenerated(chunkCoordinates, chunk);
+}
 
-                if (ignoreTravelCost) queue.push(here);
-                else if (getTile(here).isTravellable()) priorityQueue.push(std::make_pair(here, path));
-                
-                map.emplace(here, path);
+void Board::insertGenerated(std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+    // Complete chunks keep their tiles, so only a chunk generated from nothing is known to match the generator
+    if (board.findChunk(chunkCoordinates) == nullptr) pristine.insert(chunkCoordinates);
+    board.insertChunk(chunkCoordinates, chunk);
+    indexFeatures(chunkCoordinates);
+    dirty.insert(chunkCoordinates);
+}
 
-                if (!checkBiome && !checkFeature){
-                    if (here == end) return map.at(here);
-                }
-                else{
-                    bool match = false;
-                    int biomeHere = getTile(here).getBiome();
-                    int featureHere = getTile(here).getFeature();
+bool Board::chunkPristine(std::pair<int,int> chunkCoordinates) const {
+    return pristine.count(chunkCoordinates);
+}
 
-                    if (checkBiome && biomeHere == biome) match = true;
-                    if (checkFeature) match = false;
-                    if (checkFeature && (featureHere == feature || (feature == featGen.any && featureHere != featGen.none))) match = true;
+std::vector<std::pair<std::pair<int,int>, Chunk>> Board::takeDirtyChunks(){
+    std::vector<std::pair<std::pair<int,int>, Chunk>> chunks;
+    chunks.reserve(dirty.size());
+    for (auto& chunkCoordinates : dirty) chunks.emplace_back(chunkCoordinates, *board.findChunk(chunkCoordinates));
+    dirty.clear();
+    return chunks;
+}
 
-                    if (match) matches++;
-                    if (matches > toSkip) return map.at(here);
-                }
-            }
+template <typename Visit>
+bool Board::scanRegion(std::pair<int,int> center, int radius, Visit visit) const {
+    if (radius < 0) return true;
+    auto first = std::make_pair(center.first - radius, center.second - radius);
+    auto last = std::make_pair(center.first + radius, center.second + radius);
+    auto firstChunk = ChunkMap::chunkCoordinates(first);
+    auto lastChunk = ChunkMap::chunkCoordinates(last);
+    for (int i = firstChunk.first; i <= lastChunk.first; i++){
+        for (int j = firstChunk.second; j <= lastChunk.second; j++){
+            std::pair here = std::make_pair(i,j);
+            if (!visit(here, board.findChunk(here), rectangleMask(here, first, last))) return false;
         }
-        map.erase(previous);
     }
-    Path path;
-    path.tilesTraversed = -1;
-    path.travelCost = -1;
-    return path;
+    return true;
 }
 
-void Board::generateBoard(){
-    for (int radius = 0; radius <= viewSize/2; radius++){
-        auto coordinatesInRing = getCoordinatesInRing(std::make_pair(0,0), radius);
-        for (auto& here : coordinatesInRing) generateTile(here);
+bool Board::regionReady(std::pair<int,int> center, int radius) const {
+    return scanRegion(center, radius, [](std::pair<int,int>, const Chunk* chunk, const ChunkMask& inside){
+        if (chunk == nullptr) return false;
+        ChunkMask ready = scanChunk(*chunk, TilePattern::ready());
+        for (std::size_t i = 0; i < inside.size(); i++) if ((ready[i] & inside[i]) != inside[i]) return false;
+        return true;
+    });
+}
+
+bool Board::regionExists(std::pair<int,int> center, int radius) const {
+    return scanRegion(center, radius, [](std::pair<int,int>, const Chunk* chunk, const ChunkMask& inside){
+        if (chunk == nullptr) return false;
+        for (std::size_t i = 0; i < inside.size(); i++) if ((chunk->present[i] & inside[i]) != inside[i]) return false;
+        return true;
+    });
+}
+
+std::vector<std::pair<int,int>> Board::findTiles(std::pair<int,int> center, int radius, int biome, int feature) const {
+    std::vector<std::pair<int,int>> found;
+    TilePattern pattern = TilePattern::matching(biome, feature);
+    scanRegion(center, radius, [&](std::pair<int,int> chunkCoordinates, const Chunk* chunk, const ChunkMask& inside){
+        if (chunk == nullptr) return true;
+        ChunkMask matched = scanChunk(*chunk, pattern);
+        for (std::size_t i = 0; i < inside.size(); i++) matched[i] &= inside[i];
+        forEachInMask(matched, [&](int index){found.push_back(ChunkMap::tileCoordinates(chunkCoordinates, index));});
+        return true;
+    });
+    return found;
+}
+
+int Board::countTiles(std::pair<int,int> center, int radius, int biome, int feature) const {
+    int count = 0;
+    TilePattern pattern = TilePattern::matching(biome, feature);
+    scanRegion(center, radius, [&](std::pair<int,int>, const Chunk* chunk, const ChunkMask& inside){
+        if (chunk == nullptr) return true;
+        ChunkMask matched = scanChunk(*chunk, pattern);
+        for (std::size_t i = 0; i < inside.size(); i++) matched[i] &= inside[i];
+        count += countMask(matched);
+        return true;
+    });
+    return count;
+}
+
+std::vector<FeatureSite> Board::nearestFeatures(std::pair<int,int> position, int feature, int count, int maxDistance) const {
+    return features.nearest(position, feature, std::max(count, 0), maxDistance);
+}
+
+std::vector<FeatureSite> Board::featuresWithin(std::pair<int,int> position, int feature, int radius) const {
+    return features.within(position, feature, radius);
+}
+
+bool Board::verify(std::pair<int,int> position) const {
+    return regionExists(position, viewSize/2);
+}
+
+namespace {
+    /** Scratch space for the searches that don't get one from the caller */
+    thread_local SearchArena defaultArena;
+}
+
+bool Board::tileMatches(const Tile& tile, int biome, int feature){
+    if (feature != -1){
+        int featureHere = tile.getFeature();
+        return featureHere == feature || (feature == featGen.any && featureHere != featGen.none);
     }
+    return biome != -1 && tile.getBiome() == biome;
 }
 
-void Board::generateTile(std::pair<int,int> coordinates){
-    generateBiome(coordinates);
-    generateFeature(coordinates);
-}
-
-void Board::generateBiome(std::pair<int,int> coordinates){
-    if (tileExists(coordinates)) return;
-    int biome = pickByProbability(tileGen.biomeChances);
-    Tile tile = Tile(biome);
-    std::pair biomeSize = std::make_pair(randInt(tileGen.minBiomeSize,tileGen.maxBiomeSize),randInt(tileGen.minBiomeSize,tileGen.maxBiomeSize));
-
-    if (!tileExists(std::make_pair(coordinates.first+1,coordinates.second-1))) coordinates.first += biomeSize.first;
-    else if (!tileExists(std::make_pair(coordinates.first,coordinates.second-1))) coordinates.second -= biomeSize.second;
-    else if (!tileExists(std::make_pair(coordinates.first,coordinates.second+1))) coordinates.second += biomeSize.second;
-    else if (!tileExists(std::make_pair(coordinates.first-1,coordinates.second))) coordinates.first -= biomeSize.first;
-    else {
-        Tile adjacentTile = Tile(board.at(std::make_pair(coordinates.first-1, coordinates.second)).getBiome());
-        board.emplace(coordinates, adjacentTile);
+template <typename Visit>
+void Board::sweep(SearchArena& arena, std::pair<int,int> start, bool ignoreTravelCost, int maxDistance, Visit visit) const {
+    arena.clear();
+    if (!tileExists(start)) return;
+    arena.insert(SearchArena::Node{start, -1, 0, 0});
+
+    if (ignoreTravelCost){
+        // Breadth first, visiting tiles in the order they are discovered
+        arena.enqueue(0);
+        while (!arena.fifoEmpty()){
+            int previous = arena.dequeue();
+            SearchArena::Node current = arena.node(previous);
+            if (current.tilesTraversed + 1 > maxDistance) continue;
+
+            for (auto& here : getAdjacentCoordinates(current.coordinates)){
+                const Tile* tile = board.find(here);
+                if (tile == nullptr) continue;
+
+                auto [index, inserted] = arena.insert(SearchArena::Node{here, previous, current.tilesTraversed + 1, current.travelCost + tile->getTravelCost()});
+                if (!inserted) continue;
+                arena.enqueue(index);
+
+                if (visit(index, *tile)) return;
+            }
+        }
+        return;
     }
-    
-    int y = tileGen.minBiomeSize;
-    for (int i = (coordinates.first - biomeSize.first); i <= (coordinates.first + biomeSize.first); i++){
-        if (i == coordinates.first) y = biomeSize.second;
-        else if (i < coordinates.first) y = randInt(y,biomeSize.second);
-        else if (i > coordinates.first) y = randInt(tileGen.minBiomeSize,y);
-        for (int j = (coordinates.second - y); j <= (coordinates.second + y); j++){
-            std::pair here = std::make_pair(i,j);
-            if (!tileExists(here)) board.emplace(here, tile);
+
+    // Cheapest first, visiting tiles once their cost is final
+    arena.push(0, 0, 0);
+    while (!arena.heapEmpty()){
+        auto [estimate, cost, previous] = arena.pop();
+        SearchArena::Node current = arena.node(previous);
+        if (cost != current.travelCost) continue;
+
+        const Tile& tile = board.at(current.coordinates);
+        if (previous != 0 && visit(previous, tile)) return;
+        if (previous != 0 && !tile.isTravellable()) continue;
+
+        for (auto& here : getAdjacentCoordinates(current.coordinates)){
+            const Tile* next = board.find(here);
+            if (next == nullptr) continue;
+
+            int travelCost = current.travelCost + next->getTravelCost();
+            if (travelCost > maxDistance) continue;
+
+            SearchArena::Node node{here, previous, current.tilesTraversed + 1, travelCost};
+            auto [index, inserted] = arena.insert(node);
+            if (!inserted){
+                if (index == 0 || travelCost >= arena.node(index).travelCost) continue;
+                arena.node(index) = node;
+            }
+            arena.push(travelCost, travelCost, index);
         }
     }
 }
 
-void Board::generateFeature(std::pair<int,int> coordinates){
-    if (!getTile(coordinates).isTravellable()) return; //TEMPORARY (no features on ocean or mountains yet)
-    int feature = 0;
-    if (pickValue(featGen.featureChance)) feature = pickByProbability(featGen.featureChances);
-    board.at(coordinates).setFeature(feature);
-    if (feature != featGen.city) return;
+Path Board::pathTo(std::pair<int,int> start, int biome, int feature, bool ignoreTravelCost, int maxDistance, int toSkip, std::pair<int,int> end) const {
+    return pathTo(defaultArena, start, biome, feature, ignoreTravelCost, maxDistance, toSkip, end);
+}
+
+const Path& Board::pathTo(SearchArena& arena, std::pair<int,int> start, int biome, int feature, bool ignoreTravelCost, int maxDistance, int toSkip, std::pair<int,int> end) const {
+    if (biome == -1 && feature == -1) return findPath(arena, start, end, ignoreTravelCost, maxDistance);
+
+    int found = -1;
+    int matched = 0;
+    sweep(arena, start, ignoreTravelCost, maxDistance, [&](int index, const Tile& tile){
+        if (!tileMatches(tile, biome, feature) || ++matched <= toSkip) return false;
+        found = index;
+        return true;
+    });
+
+    if (found == -1) return arena.fail();
+    return arena.finish(found);
+}
+
+std::vector<std::vector<Path>> Board::pathsTo(std::pair<int,int> start, const std::vector<PathQuery>& queries, bool ignoreTravelCost, int maxDistance) const {
+    return pathsTo(defaultArena, start, queries, ignoreTravelCost, maxDistance);
+}
+
+std::vector<std::vector<Path>> Board::pathsTo(SearchArena& arena, std::pair<int,int> start, const std::vector<PathQuery>& queries, bool ignoreTravelCost, int maxDistance) const {
+    std::vector<std::vector<Path>> paths(queries.size());
+    // Coordinates can only be reached once, however many matches are asked for
+    auto wanted = [](const PathQuery& query){
+        return query.biome == -1 && query.feature == -1 ? std::min(query.count, 1) : query.count;
+    };
+    std::size_t remaining = 0;
+    for (std::size_t i = 0; i < queries.size(); i++){
+        const PathQuery& query = queries[i];
+        if (wanted(query) <= 0) continue;
+        // The sweep never visits the start, so reaching it is handled here (as findPath would)
+        if (query.biome == -1 && query.feature == -1 && query.end == start && tileExists(start)) paths[i].push_back(Path());
+        else remaining++;
+    }
+    if (remaining == 0) return paths;
 
-    int numDistricts = randInt(featGen.minCityDistricts, featGen.maxCityDistricts);
-    if (numDistricts > 1){
-        int cityRadius = (int)floor(ceil(sqrt(numDistricts))/2);
+    sweep(arena, start, ignoreTravelCost, maxDistance, [&](int index, const Tile& tile){
+        std::pair<int,int> here = arena.node(index).coordinates;
+        for (std::size_t i = 0; i < queries.size(); i++){
+            const PathQuery& query = queries[i];
+            if ((int)paths[i].size() >= wanted(query)) continue;
 
-        bool generateHarbour = false;
-        if (numDistricts > 2){
-            generateHarbour = true;
-            numDistricts--;
+            bool match;
+            if (query.biome == -1 && query.feature == -1) match = here == query.end;
+            else match = tileMatches(tile, query.biome, query.feature);
+            if (!match) continue;
+
+            paths[i].push_back(arena.finish(index));
+            if ((int)paths[i].size() == wanted(query)) remaining--;
         }
-        std::queue<int> districtsToGenerate;
-        for (int i = 0; i < numDistricts; i++){
-            if (i == 0) districtsToGenerate.push(featGen.cityMarket);
-            else districtsToGenerate.push(pickByProbability(featGen.cityDistrictChances));
+        return remaining == 0;
+    });
+    return paths;
+}
+
+Board::Heuristic Board::manhattanHeuristic(bool ignoreTravelCost){
+    int minTravelCost = 1;
+    if (!ignoreTravelCost) minTravelCost = *std::min_element(tileGen.biomeTravelCosts.begin(), tileGen.biomeTravelCosts.end());
+    return [minTravelCost](std::pair<int,int> from, std::pair<int,int> to){
+        return (std::abs(from.first - to.first) + std::abs(from.second - to.second)) * minTravelCost;
+    };
+}
+
+Path Board::findPath(std::pair<int,int> start, std::pair<int,int> end, bool ignoreTravelCost, int maxDistance, Heuristic heuristic) const {
+    return findPath(defaultArena, start, end, ignoreTravelCost, maxDistance, heuristic);
+}
+
+const Path& Board::findPath(SearchArena& arena, std::pair<int,int> start, std::pair<int,int> end, bool ignoreTravelCost, int maxDistance, Heuristic heuristic) const {
+    if (!heuristic) heuristic = manhattanHeuristic(ignoreTravelCost);
+
+    arena.clear();
+    if (!tileExists(start)) return arena.fail();
+    arena.insert(SearchArena::Node{start, -1, 0, 0});
+    arena.push(heuristic(start, end), 0, 0);
+
+    while (!arena.heapEmpty()){
+        auto [estimate, cost, previous] = arena.pop();
+        SearchArena::Node current = arena.node(previous);
+        if (cost != (ignoreTravelCost ? current.tilesTraversed : current.travelCost)) continue;
+
+        if (current.coordinates == end) return arena.finish(previous);
+
+        for (auto& here : getAdjacentCoordinates(current.coordinates)){
+            const Tile* tile = board.find(here);
+            if (tile == nullptr) continue;
+            if (!ignoreTravelCost && here != end && !tile->isTravellable()) continue;
+
+            SearchArena::Node node{here, previous, current.tilesTraversed + 1, current.travelCost + tile->getTravelCost()};
+            int nodeCost = ignoreTravelCost ? node.tilesTraversed : node.travelCost;
+            if (nodeCost > maxDistance) continue;
+
+            auto [index, inserted] = arena.insert(node);
+            if (!inserted){
+                const SearchArena::Node& existing = arena.node(index);
+                if (index == 0 || nodeCost >= (ignoreTravelCost ? existing.tilesTraversed : existing.travelCost)) continue;
+                arena.node(index) = node;
+            }
+            arena.push(nodeCost + heuristic(here, end), nodeCost, index);
         }
-        
-        std::vector coordinatesInRadius = getCoordinatesInRadius(coordinates, cityRadius);
-        std::shuffle(coordinatesInRadius.begin(), coordinatesInRadius.end(), std::default_random_engine(seed));
-
-        for (auto& here : coordinatesInRadius){
-            if (!tileExists(here)) generateBiome(here);
-            if (getTile(here).isTravellable() && getTile(here).getFeature() == featGen.none){
-                if (generateHarbour){
-                    std::vector adjacentCoordinates = getAdjacentCoordinates(here);
-                    for (auto& adjacent : adjacentCoordinates){
-                        if (tileExists(adjacent) && getTile(adjacent).getBiome() == tileGen.ocean){
-                            board.at(here).setFeature(featGen.cityHarbour);
-                            generateHarbour = false;
-                            break;
-                        }
-                    }
-                }
-                if (getTile(here).getFeature() == featGen.none){
-                    if (!districtsToGenerate.empty()){
-                        board.at(here).setFeature(districtsToGenerate.front());
-                        districtsToGenerate.pop();
-                    }
-                }
+    }
+    return arena.fail();
+}
+
+Path Board::pathToFeature(std::pair<int,int> start, int feature, bool ignoreTravelCost, int maxDistance) const {
+    return pathToFeature(defaultArena, start, feature, ignoreTravelCost, maxDistance);
+}
+
+const Path& Board::pathToFeature(SearchArena& arena, std::pair<int,int> start, int feature, bool ignoreTravelCost, int maxDistance) const {
+    arena.clear();
+    if (!tileExists(start)) return arena.fail();
+
+    int minTravelCost = 1;
+    if (!ignoreTravelCost) minTravelCost = *std::min_element(tileGen.biomeTravelCosts.begin(), tileGen.biomeTravelCosts.end());
+    auto distance = [](std::pair<int,int> from, std::pair<int,int> to){
+        return std::abs(from.first - to.first) + std::abs(from.second - to.second);
+    };
+
+    // Features further than this can't be reached within maxDistance
+    auto nearest = features.nearest(start, feature, featureCandidates, maxDistance/minTravelCost);
+    std::vector<std::pair<int,int>> candidates;
+    for (auto& site : nearest) if (site.coordinates != start) candidates.push_back(site.coordinates);
+    if (candidates.empty()) return arena.fail();
+
+    // Features that weren't returned are at least as far from the start as the last one that was, so
+    // no tile is closer to them than that minus its own distance from the start (keeping the estimate a lower bound)
+    int beyond = (int)nearest.size() < featureCandidates ? std::numeric_limits<int>::max() : distance(start, nearest.back().coordinates);
+    auto heuristic = [&](std::pair<int,int> here){
+        int closest = beyond == std::numeric_limits<int>::max() ? beyond : beyond - distance(start, here);
+        for (auto& candidate : candidates) closest = std::min(closest, distance(here, candidate));
+        return std::max(closest, 0) * minTravelCost;
+    };
+
+    arena.insert(SearchArena::Node{start, -1, 0, 0});
+    arena.push(heuristic(start), 0, 0);
+    while (!arena.heapEmpty()){
+        auto [estimate, cost, previous] = arena.pop();
+        SearchArena::Node current = arena.node(previous);
+        if (cost != (ignoreTravelCost ? current.tilesTraversed : current.travelCost)) continue;
+
+        const Tile& tile = board.at(current.coordinates);
+        if (previous != 0 && tileMatches(tile, -1, feature)) return arena.finish(previous);
+
+        for (auto& here : getAdjacentCoordinates(current.coordinates)){
+            const Tile* next = board.find(here);
+            if (next == nullptr) continue;
+            // Like pathTo, a matching tile can end the path even where it can't be passed through
+            if (!ignoreTravelCost && !next->isTravellable() && !tileMatches(*next, -1, feature)) continue;
+
+            SearchArena::Node node{here, previous, current.tilesTraversed + 1, current.travelCost + next->getTravelCost()};
+            int nodeCost = ignoreTravelCost ? node.tilesTraversed : node.travelCost;
+            if (nodeCost > maxDistance) continue;
+
+            auto [index, inserted] = arena.insert(node);
+            if (!inserted){
+                const SearchArena::Node& existing = arena.node(index);
+                if (index == 0 || nodeCost >= (ignoreTravelCost ? existing.tilesTraversed : existing.travelCost)) continue;
+                arena.node(index) = node;
             }
+            arena.push(nodeCost + heuristic(here), nodeCost, index);
         }
     }
+    return arena.fail();
 }
 
-bool Board::tileExists(std::pair<int,int> coordinates) const {
-    if (board.find(coordinates) == board.end()) return false;
-    else return true;
+void Board::generateBoard(){
+    generateRegion(std::make_pair(0,0), viewSize/2);
 }
 
-bool Board::tileReady(std::pair<int,int> coordinates) const {
-    if (!tileExists(coordinates)) return false;
-    return board.at(coordinates).isReady();
+void Board::generateTile(std::pair<int,int> coordinates){
+    auto chunkCoordinates = ChunkMap::chunkCoordinates(coordinates);
+    pageIn(chunkCoordinates);
+    if (board.chunkComplete(chunkCoordinates)) return;
+    insertGenerated(chunkCoordinates, Generator(seed).generateChunk(chunkCoordinates));
+}
+
+void Board::generateRegion(std::pair<int,int> center, int radius, int threads){
+    auto firstChunk = ChunkMap::chunkCoordinates(std::make_pair(center.first - radius, center.second - radius));
+    auto lastChunk = ChunkMap::chunkCoordinates(std::make_pair(center.first + radius, center.second + radius));
+    std::vector<std::pair<int,int>> chunksToGenerate;
+    for (int i = firstChunk.first; i <= lastChunk.first; i++){
+        for (int j = firstChunk.second; j <= lastChunk.second; j++){
+            std::pair here = std::make_pair(i,j);
+            pageIn(here);
+            if (!board.chunkComplete(here)) chunksToGenerate.push_back(here);
+        }
+    }
+
+    if (threads <= 0) threads = (int)chunksToGenerate.size() < parallelChunks ? 1 : ThreadPool::defaultThreads();
+    if (threads > (int)chunksToGenerate.size()) threads = chunksToGenerate.size();
+    Generator generator(seed);
+    if (threads <= 1){
+        for (auto& here : chunksToGenerate) insertGenerated(here, generator.generateChunk(here));
+        return;
+    }
+
+    ThreadPool pool(threads);
+    std::vector<std::future<Chunk>> chunks;
+    chunks.reserve(chunksToGenerate.size());
+    for (auto& here : chunksToGenerate){
+        chunks.push_back(pool.submit([generator, here]{return generator.generateChunk(here);}));
+    }
+    for (std::size_t i = 0; i < chunksToGenerate.size(); i++) insertGenerated(chunksToGenerate[i], chunks[i].get());
 }
 
-bool Board::CompareTravelCost::operator()(const std::pair<std::pair<int,int>,Path>& lhs, const std::pair<std::pair<int,int>,Path>& rhs) const {
-    return lhs.second.travelCost < rhs.second.travelCost;
+bool Board::tileExists(std::pair<int,int> coordinates) const {
+    return board.contains(coordinates);
+}
+
+bool Board::tileReady(std::pair<int,int> coordinates) const {
+    const Tile* tile = board.find(coordinates);
+    if (tile == nullptr) return false;
+    return tile->isReady();
 }
\ No newline at end of file
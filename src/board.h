@@ -1,11 +1,19 @@
 #ifndef BOARD
 #define BOARD
 
-#include <map>
+#include <functional>
+#include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 #include <cereal/archives/json.hpp>
+#include "chunk.h"
+#include "featureindex.h"
 #include "tile.h"
+#include "tilescan.h"
+
+class SearchArena;
+class WorldFile;
 
 /**
  * @brief Construct used to contain all data related to a path between two tiles
@@ -20,6 +28,21 @@ struct Path{
     std::vector<std::pair<int,int>> steps;
 };
 
+/**
+ * @brief Construct used to describe one target of a batched path query
+ * 
+ */
+struct PathQuery{
+    /** Biome to look for (-1 to ignore) */
+    int biome = -1;
+    /** Feature to look for (-1 to ignore) */
+    int feature = -1;
+    /** End position (used if both biome and feature are -1) */
+    std::pair<int,int> end = std::make_pair(0,0);
+    /** How many matches to return */
+    int count = 1;
+};
+
 /**
  * @brief Generates and manages the game board
  * 
@@ -27,10 +50,22 @@ struct Path{
 class Board{
     /** The amount of the board that's viewed (and generated at once) */
     static const int viewSize = 21;
-    /** Map of coordinates to tiles, contains the board */
-    std::map<std::pair<int,int>, Tile> board;
+    /** How many of the nearest indexed features guide the search in pathToFeature */
+    static const int featureCandidates = 16;
+    /** Fewest chunks generateRegion starts a pool of workers for by default, smaller regions are generated inline */
+    static const int parallelChunks = 16;
+    /** Chunked storage of coordinates to tiles, contains the board */
+    ChunkMap board;
     /** Seed used in generation of the board */
     int seed;
+    /** World file chunks are paged in from before being generated (if any) */
+    std::shared_ptr<WorldFile> source;
+    /** Chunks changed since they were last taken to be saved */
+    std::unordered_set<std::pair<int,int>, CoordinateHash> dirty;
+    /** Chunks known to be exactly what the generator makes for them (anything that changes their tiles must remove them) */
+    std::unordered_set<std::pair<int,int>, CoordinateHash> pristine;
+    /** Features on the board by chunk, updated whenever a chunk is added */
+    FeatureIndex features;
 
     /**
      * @brief Generates the board on first load
@@ -39,39 +74,35 @@ class Board{
     void generateBoard();
 
     /**
-     * @brief Generate tile at the given coordinates
+     * @brief Generate the chunk containing the given coordinates
+     * 
+     * Tiles that already exist are kept.
      * 
      * @param coordinates x,y pair of coordinates
      */
     void generateTile(std::pair<int, int> coordinates);
 
     /**
-     * @brief Generates biome from the given coordinates
+     * @brief Add a chunk made by the generator for the board's seed
      * 
-     * This function essentially generates biomes in "splotches".
-     * For a given coordinate, if there is no biome present,
-     * it checks direction it can generate a new biome into.
-     * It then moves in that direction a random amount (this
-     * amount is determined by min and max biome size), and
-     * generates a splotch a random number of tiles in each
-     * direction, ensuring to cover the original coordinates
-     * too.
-     * 
-     * @param coordinates x,y pair of coordinates
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param chunk Generated chunk
      */
-    void generateBiome(std::pair<int, int> coordinates);
+    void insertGenerated(std::pair<int,int> chunkCoordinates, const Chunk& chunk);
 
     /**
-     * @brief Generates feature at the given coordinates
+     * @brief Read a chunk from the world file if none of its tiles are on the board yet
      * 
-     * For most features this is straightForward. Cities however
-     * are multi-tile and will sometimes overwrite nearby features
-     * or even generate new tiles for the rest of the city
-     * to generate.
+     * @param chunkCoordinates Coordinates of the chunk
+     */
+    void pageIn(std::pair<int,int> chunkCoordinates);
+
+    /**
+     * @brief Index the features of a chunk again, after its tiles changed
      * 
-     * @param coordinates x,y pair of coordinates
+     * @param chunkCoordinates Coordinates of the chunk
      */
-    void generateFeature(std::pair<int, int> coordinates);
+    void indexFeatures(std::pair<int,int> chunkCoordinates);
 
     /**
      * @brief Check if the given coordinates contain a generated tile
@@ -82,30 +113,63 @@ class Board{
     bool tileExists(std::pair<int,int> coordinates) const;
 
     /**
-     * @brief Check if the given coordinates contain a ready tile
+     * @brief Check if a tile matches a biome and/or feature
      * 
-     * @param coordinates x,y pair of coordinates
-     * @return Whether or not the specified coordinates contain a ready tile 
+     * A feature, if given, takes precedence over the biome.
+     * 
+     * @param tile Tile to check
+     * @param biome Biome to look for (-1 to ignore)
+     * @param feature Feature to look for (-1 to ignore, featGen.any for any feature)
+     * @return Whether or not the tile matches
      */
-    bool tileReady(std::pair<int,int> coordinates) const;
+    static bool tileMatches(const Tile& tile, int biome, int feature);
 
     /**
-     * @brief Implements travel cost comparison for tiles by coordinate
+     * @brief Sweep outwards from some coordinates, visiting each reached tile once
      * 
+     * Breadth first when travel cost is ignored (tiles are visited when discovered),
+     * cheapest first otherwise (tiles are visited once their cost is final, and those
+     * that can't be travelled are visited but not passed through). The start is not visited.
+     * 
+     * @param arena Search arena to hold the search state (cleared first)
+     * @param start Starting position
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @param maxDistance Maximum distance to search (implemented as tiles or travel cost depending on ignoreTravelCost)
+     * @param visit Called with the node index and tile of each visited tile, returns true to stop the sweep
      */
-    class CompareTravelCost{
-    public:
-        /**
-         * @brief Implements travel cost comparison for tiles by coordinate
-         * 
-         * @param lhs The coordinate left of the operator
-         * @param rhs The coordinate right of the operator
-         * @return True if rhs > lhs
-         */
-        bool operator()(const std::pair<std::pair<int,int>,Path>& lhs, const std::pair<std::pair<int,int>,Path>& rhs) const;
-    };
+    template <typename Visit>
+    void sweep(SearchArena& arena, std::pair<int,int> start, bool ignoreTravelCost, int maxDistance, Visit visit) const;
+
+    /**
+     * @brief Visit every chunk overlapping a square region, with the mask of its tiles inside the region
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @param visit Called with the chunk coordinates, the chunk (nullptr if it doesn't exist) and the mask, returns false to stop
+     * @return Whether or not every chunk was visited
+     */
+    template <typename Visit>
+    bool scanRegion(std::pair<int,int> center, int radius, Visit visit) const;
+
+    /** Selects the constructor that generates nothing */
+    struct Empty{};
+
+    /**
+     * @brief Build an empty board for deserialization to fill
+     * 
+     */
+    Board(Empty);
+
+    friend Board load(std::string savename, std::pair<int,int> position, bool json);
 
 public:
+    /**
+     * @brief Estimates the cost of travelling from some coordinates to a destination
+     * 
+     * Must never overestimate, or paths found with it may not be the shortest.
+     */
+    using Heuristic = std::function<int(std::pair<int,int> from, std::pair<int,int> to)>;
+
     /**
      * @brief Build new board centered at 0,0
      * 
@@ -119,6 +183,17 @@ public:
      */
     Board(int seed);
 
+    /**
+     * @brief Open a board from a world file, reading only the chunks in view of a position
+     * 
+     * Chunks in view that aren't in the file are generated. Other chunks are read
+     * from the file as they are generated, instead of generating them.
+     * 
+     * @param source World file to read
+     * @param position Position of the player
+     */
+    Board(std::shared_ptr<WorldFile> source, std::pair<int,int> position);
+
     /**
      * @brief Destroy the Board object (default deconstructor)
      * 
@@ -132,11 +207,33 @@ public:
      * @param archive 
      */
     template<class Archive>
-    void serialize(Archive& archive){
+    void save(Archive& archive) const {
+        archive(
+            cereal::make_nvp("Seed",seed),
+            cereal::make_nvp("Board",board)
+        );
+    }
+
+    /**
+     * @brief Allows deserialization of board class
+     * 
+     * @tparam Archive 
+     * @param archive 
+     */
+    template<class Archive>
+    void load(Archive& archive){
         archive(
             cereal::make_nvp("Seed",seed),
             cereal::make_nvp("Board",board)
         );
+        // Every chunk read has yet to be saved anywhere else, and none is known to match the generator
+        features.clear();
+        dirty.clear();
+        pristine.clear();
+        board.forEachChunk([this](std::pair<int,int> chunkCoordinates, const Chunk&){
+            indexFeatures(chunkCoordinates);
+            dirty.insert(chunkCoordinates);
+        });
     }
 
     /**
@@ -161,6 +258,169 @@ public:
      */
     Tile getTile(std::pair<int,int> coordinates) const;
 
+    /**
+     * @brief Generates every chunk touching a square region, in parallel
+     * 
+     * Chunks are independent of each other, so they are generated at the
+     * same time by a pool of workers and then added to the board. Tiles
+     * that already exist are kept. Starting the pool costs more than a few
+     * chunks take to generate, so small regions (like the view generated
+     * by the constructors) are generated inline unless threads is given.
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @param threads Number of workers to use (0 to use one per hardware thread, or none for small regions)
+     */
+    void generateRegion(std::pair<int,int> center, int radius, int threads = 0);
+
+    /**
+     * @brief Check if every tile of a chunk has been generated
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Whether or not the chunk is generated
+     */
+    bool chunkGenerated(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Get a chunk of the board
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Pointer to the chunk, or nullptr if none of its tiles exist
+     */
+    const Chunk* getChunk(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Call a function for every chunk on the board
+     * 
+     * Chunks still waiting in the world file are not included.
+     * 
+     * @tparam Function Callable taking chunk coordinates and a chunk
+     * @param function Function to call
+     */
+    template<class Function>
+    void forEachChunk(Function function) const {board.forEachChunk(function);}
+
+    /**
+     * @brief Get the world file chunks are paged in from
+     * 
+     * @return World file, or nullptr if there is none
+     */
+    std::shared_ptr<WorldFile> getSource() const;
+
+    /**
+     * @brief Add a chunk generated elsewhere to the board
+     * 
+     * Tiles that already exist (or are waiting in the world file) are kept.
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param chunk Generated chunk
+     */
+    void addChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk);
+
+    /**
+     * @brief Add a chunk made elsewhere by a Generator with the board's seed
+     * 
+     * Same as addChunk, but the chunk can be left out of saves that only store
+     * what differs from the generator.
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param chunk Generated chunk
+     */
+    void addGeneratedChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk);
+
+    /**
+     * @brief Check if a chunk is known to be exactly what the generator makes for it
+     * 
+     * Only chunks generated on this board from nothing are known to be. Chunks
+     * added, paged in or loaded are not, even if they happen to match.
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Whether or not the chunk is known to match the generator
+     */
+    bool chunkPristine(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Copy out every chunk changed since the last call, and mark them clean
+     * 
+     * Chunks change when they are generated or added. Chunks paged in from the
+     * world file unchanged are not included.
+     * 
+     * @return Chunk coordinates and copies of the chunks
+     */
+    std::vector<std::pair<std::pair<int,int>, Chunk>> takeDirtyChunks();
+
+    /**
+     * @brief Check if the given coordinates contain a ready tile
+     * 
+     * @param coordinates x,y pair of coordinates
+     * @return Whether or not the specified coordinates contain a ready tile 
+     */
+    bool tileReady(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Check if every tile in a square region is ready
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @return Whether or not the region is ready
+     */
+    bool regionReady(std::pair<int,int> center, int radius) const;
+
+    /**
+     * @brief Check if every tile in a square region exists
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @return Whether or not the region exists
+     */
+    bool regionExists(std::pair<int,int> center, int radius) const;
+
+    /**
+     * @brief Find every tile in a square region that matches a biome and/or feature
+     * 
+     * Tiles are matched like pathTo matches them, but tested a chunk at a time
+     * with the fastest scan kernel the processor has.
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @param biome Biome to look for (-1 to ignore)
+     * @param feature Feature to look for (-1 to ignore, featGen.any for any feature)
+     * @return Coordinates of the matching tiles, chunk by chunk
+     */
+    std::vector<std::pair<int,int>> findTiles(std::pair<int,int> center, int radius, int biome, int feature) const;
+
+    /**
+     * @brief Count the tiles in a square region that match a biome and/or feature
+     * 
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     * @param biome Biome to look for (-1 to ignore)
+     * @param feature Feature to look for (-1 to ignore, featGen.any for any feature)
+     * @return Number of matching tiles
+     */
+    int countTiles(std::pair<int,int> center, int radius, int biome, int feature) const;
+
+    /**
+     * @brief Find the features closest to a position by Manhattan distance, from the feature index
+     * 
+     * @param position Position to measure from
+     * @param feature Feature to look for (featGen.any for any feature)
+     * @param count Most features to find
+     * @param maxDistance Farthest distance to look
+     * @return The features, nearest first
+     */
+    std::vector<FeatureSite> nearestFeatures(std::pair<int,int> position, int feature, int count, int maxDistance) const;
+
+    /**
+     * @brief Find every feature within a Manhattan distance of a position, from the feature index
+     * 
+     * @param position Position to measure from
+     * @param feature Feature to look for (featGen.any for any feature)
+     * @param radius Farthest distance to look
+     * @return The features, nearest first
+     */
+    std::vector<FeatureSite> featuresWithin(std::pair<int,int> position, int feature, int radius) const;
+
     /**
      * @brief Verify board integrity
      * 
@@ -172,8 +432,9 @@ public:
     /**
      * @brief Generates a path between a starting coordinates and some tile, up to a maximum distance
      * 
-     * Uses a BFS algorithm to find the shortest path between two tiles. If both biome and feature are -1,
-     * the algorithm searches by coordinates. Otherwise it tries to match biome and/or feature.
+     * If both biome and feature are -1, the algorithm searches by coordinates (using findPath). Otherwise it
+     * tries to match biome and/or feature: breadth first when travel cost is ignored, cheapest first otherwise.
+     * Search state is kept in a SearchArena reused by the calling thread.
      *
      * @param start Starting position
      * @param biome Biome to look for (-1 to ignore)
@@ -193,6 +454,130 @@ public:
         int toSkip,
         std::pair<int,int> end = std::make_pair(0,0)
     ) const;
+
+    /**
+     * @brief Generates a path between a starting coordinates and some tile, using the given search arena
+     * 
+     * Same as pathTo, but callers running many searches can keep their own arena around.
+     *
+     * @param arena Search arena to hold the search state (cleared first)
+     * @return The path held by the arena, valid until its next search
+     */
+    const Path& pathTo(
+        SearchArena& arena,
+        std::pair<int,int> start,
+        int biome,
+        int feature,
+        bool ignoreTravelCost,
+        int maxDistance,
+        int toSkip,
+        std::pair<int,int> end = std::make_pair(0,0)
+    ) const;
+
+    /**
+     * @brief Generates paths from a starting coordinates to several targets in a single sweep
+     * 
+     * Each query is matched the same way pathTo would match it, and gets the paths to its first
+     * count matches (fewer if the sweep runs out first), in the order pathTo would find them
+     * with increasing toSkip. The sweep stops as soon as every query has all of its matches.
+     *
+     * @param start Starting position
+     * @param queries Targets to look for
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @param maxDistance Maximum distance to search (implemented as tiles or travel cost depending on ignoreTravelCost)
+     * @return The paths found for each query, in the order of the queries
+     */
+    std::vector<std::vector<Path>> pathsTo(
+        std::pair<int,int> start,
+        const std::vector<PathQuery>& queries,
+        bool ignoreTravelCost,
+        int maxDistance
+    ) const;
+
+    /**
+     * @brief Generates paths from a starting coordinates to several targets in a single sweep, using the given search arena
+     * 
+     * @param arena Search arena to hold the search state (cleared first)
+     * @return The paths found for each query, in the order of the queries
+     */
+    std::vector<std::vector<Path>> pathsTo(
+        SearchArena& arena,
+        std::pair<int,int> start,
+        const std::vector<PathQuery>& queries,
+        bool ignoreTravelCost,
+        int maxDistance
+    ) const;
+
+    /**
+     * @brief Get the Manhattan distance heuristic scaled by the cheapest tile to travel
+     * 
+     * @param ignoreTravelCost Whether or not travel cost is ignored (every tile costs 1)
+     * @return Heuristic
+     */
+    static Heuristic manhattanHeuristic(bool ignoreTravelCost);
+
+    /**
+     * @brief Generates the shortest path between two coordinates, up to a maximum distance
+     * 
+     * Uses A*, guided by the heuristic. Search state lives in a SearchArena reused by
+     * the calling thread, and the steps are only rebuilt from parent indices once the end is reached. When travel cost is respected,
+     * tiles that can't be travelled are never passed through (but can be the end).
+     * 
+     * @param start Starting position
+     * @param end End position
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @param maxDistance Maximum distance to search (implemented as tiles or travel cost depending on ignoreTravelCost)
+     * @param heuristic Heuristic guiding the search (Manhattan distance if empty)
+     * @return The path from start to end, or a path with -1 tiles traversed if there is none
+     */
+    Path findPath(
+        std::pair<int,int> start,
+        std::pair<int,int> end,
+        bool ignoreTravelCost,
+        int maxDistance,
+        Heuristic heuristic = nullptr
+    ) const;
+
+    /**
+     * @brief Generates the shortest path between two coordinates, using the given search arena
+     * 
+     * Same as findPath, but callers running many searches can keep their own arena around.
+     *
+     * @param arena Search arena to hold the search state (cleared first)
+     * @return The path held by the arena, valid until its next search
+     */
+    const Path& findPath(
+        SearchArena& arena,
+        std::pair<int,int> start,
+        std::pair<int,int> end,
+        bool ignoreTravelCost,
+        int maxDistance,
+        Heuristic heuristic = nullptr
+    ) const;
+
+    /**
+     * @brief Generates the cheapest path to a feature, with the search guided toward the features indexed nearby
+     * 
+     * An A* search that ends at the first matching tile, estimating the cost left from each tile by its
+     * distance to the nearest few features the index finds. The estimate never exceeds the real cost,
+     * so the path costs the same as pathTo's for the feature with nothing skipped, but it may end at a
+     * different feature when several cost the same.
+     * 
+     * @param start Starting position
+     * @param feature Feature to look for (featGen.any for any feature)
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @param maxDistance Maximum distance to search (implemented as tiles or travel cost depending on ignoreTravelCost)
+     * @return The path to the feature, or a path with -1 tiles traversed if none can be reached
+     */
+    Path pathToFeature(std::pair<int,int> start, int feature, bool ignoreTravelCost, int maxDistance) const;
+
+    /**
+     * @brief Generates the cheapest path to a feature, with the search guided toward the features indexed nearby, using the given search arena
+     * 
+     * @param arena Search arena to hold the search state (cleared first)
+     * @return The path held by the arena, valid until its next search
+     */
+    const Path& pathToFeature(SearchArena& arena, std::pair<int,int> start, int feature, bool ignoreTravelCost, int maxDistance) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "chunk.h"
+
+#include <bitset>
+#include "exceptions.h"
+
+bool Chunk::contains(int index) const {
+    return (present[index/64] >> (index%64)) & 1;
+}
+
+void Chunk::set(int index, const Tile& tile){
+    tiles[index] = tile;
+    present[index/64] |= std::uint64_t(1) << (index%64);
+}
+
+int Chunk::count() const {
+    int total = 0;
+    for (auto& word : present) total += std::bitset<64>(word).count();
+    return total;
+}
+
+std::pair<int,int> ChunkMap::chunkCoordinates(std::pair<int,int> coordinates){
+    auto floorDivide = [](int value){return (value >= 0 ? value : value - Chunk::size + 1) / Chunk::size;};
+    return std::make_pair(floorDivide(coordinates.first), floorDivide(coordinates.second));
+}
+
+int ChunkMap::localIndex(std::pair<int,int> coordinates){
+    auto chunk = chunkCoordinates(coordinates);
+    return (coordinates.first - chunk.first*Chunk::size)*Chunk::size + (coordinates.second - chunk.second*Chunk::size);
+}
+
+std::pair<int,int> ChunkMap::tileCoordinates(std::pair<int,int> chunkCoordinates, int index){
+    return std::make_pair(chunkCoordinates.first*Chunk::size + index/Chunk::size, chunkCoordinates.second*Chunk::size + index%Chunk::size);
+}
+
+bool ChunkMap::contains(std::pair<int,int> coordinates) const {
+    return find(coordinates) != nullptr;
+}
+
+const Tile* ChunkMap::find(std::pair<int,int> coordinates) const {
+    const Chunk* chunk = findChunk(chunkCoordinates(coordinates));
+    if (chunk == nullptr) return nullptr;
+    int index = localIndex(coordinates);
+    if (!chunk->contains(index)) return nullptr;
+    return &chunk->tiles[index];
+}
+
+const Tile& ChunkMap::at(std::pair<int,int> coordinates) const {
+    const Tile* tile = find(coordinates);
+    if (tile == nullptr) throw TileMissingException();
+    return *tile;
+}
+
+Tile& ChunkMap::at(std::pair<int,int> coordinates){
+    static_cast<const ChunkMap&>(*this).at(coordinates);
+    return own(chunkCoordinates(coordinates)).tiles[localIndex(coordinates)];
+}
+
+Chunk& ChunkMap::own(std::pair<int,int> chunkCoordinates){
+    auto [position, inserted] = index.insert(chunkCoordinates, chunks.size());
+    if (inserted){
+        chunks.emplace_back();
+        return chunks.back();
+    }
+    if (*position >= 0) return chunks[*position];
+    chunks.push_back(*views[-1 - *position]);
+    *position = chunks.size() - 1;
+    return chunks.back();
+}
+
+bool ChunkMap::emplace(std::pair<int,int> coordinates, const Tile& tile){
+    Chunk& chunk = own(chunkCoordinates(coordinates));
+    int index = localIndex(coordinates);
+    if (chunk.contains(index)) return false;
+    chunk.set(index, tile);
+    tileCount++;
+    return true;
+}
+
+const Chunk* ChunkMap::findChunk(std::pair<int,int> chunkCoordinates) const {
+    const int* position = index.find(chunkCoordinates);
+    if (position == nullptr) return nullptr;
+    return *position >= 0 ? &chunks[*position] : views[-1 - *position];
+}
+
+bool ChunkMap::chunkComplete(std::pair<int,int> chunkCoordinates) const {
+    const Chunk* chunk = findChunk(chunkCoordinates);
+    return chunk != nullptr && chunk->count() == Chunk::area;
+}
+
+void ChunkMap::insertChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+    if (index.insert(chunkCoordinates, chunks.size()).second){
+        chunks.push_back(chunk);
+        tileCount += chunk.count();
+        return;
+    }
+    Chunk& existing = own(chunkCoordinates);
+    for (int i = 0; i < Chunk::area; i++){
+        if (chunk.contains(i) && !existing.contains(i)){
+            existing.set(i, chunk.tiles[i]);
+            tileCount++;
+        }
+    }
+}
+
+void ChunkMap::insertView(std::pair<int,int> chunkCoordinates, const Chunk* chunk){
+    if (index.find(chunkCoordinates) != nullptr){
+        insertChunk(chunkCoordinates, *chunk);
+        return;
+    }
+    index.insert(chunkCoordinates, -1 - (int)views.size());
+    views.push_back(chunk);
+    tileCount += chunk->count();
+}
+
+std::size_t ChunkMap::size() const {return tileCount;}
+
+void ChunkMap::clear(){
+    chunks.clear();
+    views.clear();
+    index.clear();
+    tileCount = 0;
+}
\ No newline at end of file
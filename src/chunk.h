@@ -0,0 +1,263 @@
+#ifndef CHUNK
+#define CHUNK
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <cereal/archives/json.hpp>
+#include <cereal/types/utility.hpp>
+#include "flatmap.h"
+#include "tile.h"
+
+/**
+ * @brief A fixed-size square block of tiles stored densely
+ *
+ * Tiles are addressed by their index inside the chunk, and a
+ * presence mask records which of them have been generated. Tiles
+ * are packed into one byte each and kept apart from the presence
+ * mask, so a chunk is a little over a byte per tile.
+ */
+struct Chunk{
+    /** Side length of a chunk in tiles */
+    static constexpr int size = 16;
+    /** Number of tiles in a chunk */
+    static constexpr int area = size*size;
+
+    /** One bit per tile, set when the tile exists */
+    std::array<std::uint64_t, area/64> present{};
+    /** Dense tile storage, indexed by local index */
+    std::array<Tile, area> tiles;
+
+    /**
+     * @brief Check if the tile at the local index exists
+     *
+     * @param index Local index of the tile
+     * @return Whether or not the tile exists
+     */
+    bool contains(int index) const;
+
+    /**
+     * @brief Store a tile at the local index and mark it present
+     *
+     * @param index Local index of the tile
+     * @param tile Tile to store
+     */
+    void set(int index, const Tile& tile);
+
+    /**
+     * @brief Count the tiles present in the chunk
+     *
+     * @return Number of tiles present
+     */
+    int count() const;
+};
+
+/**
+ * @brief Sparse, chunked storage of tiles by coordinate
+ *
+ * Chunks are found through a flat hash index on chunk coordinates, and tiles
+ * are found in constant time inside their chunk. Chunks can also be viewed
+ * in place from storage owned elsewhere (such as a mapped world file), and
+ * are only copied in once changed. Serializes in the same format as a
+ * std::map of coordinates to tiles.
+ */
+class ChunkMap{
+    /** Chunks owned by the map, which never move once added */
+    std::deque<Chunk> chunks;
+    /** Chunks viewed in place (a view stays here after it is copied into chunks) */
+    std::vector<const Chunk*> views;
+    /** Index of chunk coordinates to a position in chunks, or -1 minus a position in views */
+    FlatMap<int> index;
+    /** Number of tiles present across all chunks */
+    std::size_t tileCount = 0;
+
+    /**
+     * @brief Get a chunk that can be changed, copying it in if it is only viewed
+     *
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Chunk (empty if it didn't exist)
+     */
+    Chunk& own(std::pair<int,int> chunkCoordinates);
+public:
+    /**
+     * @brief Get the coordinates of the chunk containing some coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Chunk coordinates
+     */
+    static std::pair<int,int> chunkCoordinates(std::pair<int,int> coordinates);
+
+    /**
+     * @brief Get the index of some coordinates inside their chunk
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Local index
+     */
+    static int localIndex(std::pair<int,int> coordinates);
+
+    /**
+     * @brief Get the coordinates of a local index inside a chunk
+     *
+     * @param chunkCoordinates Chunk coordinates
+     * @param index Local index
+     * @return x,y pair of coordinates
+     */
+    static std::pair<int,int> tileCoordinates(std::pair<int,int> chunkCoordinates, int index);
+
+    /**
+     * @brief Check if the coordinates contain a tile
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Whether or not a tile exists at the coordinates
+     */
+    bool contains(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Find the tile at the coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Pointer to the tile, or nullptr if there is none
+     */
+    const Tile* find(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Get the tile at the coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Tile at the coordinates
+     * @throws TileMissingException if there is no tile at the coordinates
+     */
+    const Tile& at(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Get the tile at the coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Tile at the coordinates
+     * @throws TileMissingException if there is no tile at the coordinates
+     */
+    Tile& at(std::pair<int,int> coordinates);
+
+    /**
+     * @brief Insert a tile if the coordinates don't already contain one
+     *
+     * @param coordinates x,y pair of coordinates
+     * @param tile Tile to insert
+     * @return Whether or not the tile was inserted
+     */
+    bool emplace(std::pair<int,int> coordinates, const Tile& tile);
+
+    /**
+     * @brief Find the chunk at the chunk coordinates
+     *
+     * @param chunkCoordinates Chunk coordinates
+     * @return Pointer to the chunk, or nullptr if there is none
+     */
+    const Chunk* findChunk(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Check if every tile of a chunk exists
+     *
+     * @param chunkCoordinates Chunk coordinates
+     * @return Whether or not the chunk is complete
+     */
+    bool chunkComplete(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Insert the tiles of a chunk that don't already exist
+     *
+     * @param chunkCoordinates Chunk coordinates
+     * @param chunk Chunk to take tiles from
+     */
+    void insertChunk(std::pair<int,int> chunkCoordinates, const Chunk& chunk);
+
+    /**
+     * @brief Add a chunk viewed in place, without copying it
+     *
+     * The chunk must outlive the map (and any copies of it). If some tiles of
+     * the chunk are already stored, it is merged in by copy like insertChunk.
+     *
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param chunk Chunk to view
+     */
+    void insertView(std::pair<int,int> chunkCoordinates, const Chunk* chunk);
+
+    /**
+     * @brief Get the number of tiles stored
+     *
+     * @return Number of tiles
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Remove all tiles
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Call a function for every stored tile
+     *
+     * @tparam Function Callable taking coordinates and a tile
+     * @param function Function to call
+     */
+    template<class Function>
+    void forEach(Function function) const {
+        forEachChunk([&](std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+            for (int i = 0; i < Chunk::area; i++){
+                if (chunk.contains(i)) function(tileCoordinates(chunkCoordinates, i), chunk.tiles[i]);
+            }
+        });
+    }
+
+    /**
+     * @brief Call a function for every stored chunk
+     *
+     * @tparam Function Callable taking chunk coordinates and a chunk
+     * @param function Function to call
+     */
+    template<class Function>
+    void forEachChunk(Function function) const {
+        index.forEach([&](std::pair<int,int> chunkCoordinates, int position){
+            function(chunkCoordinates, position >= 0 ? chunks[position] : *views[-1 - position]);
+        });
+    }
+
+    /**
+     * @brief Allows serialization of chunk map class
+     *
+     * @tparam Archive
+     * @param archive
+     */
+    template<class Archive>
+    void save(Archive& archive) const {
+        archive(cereal::make_size_tag(static_cast<cereal::size_type>(tileCount)));
+        forEach([&archive](std::pair<int,int> coordinates, const Tile& tile){
+            archive(cereal::make_map_item(coordinates, tile));
+        });
+    }
+
+    /**
+     * @brief Allows deserialization of chunk map class
+     *
+     * @tparam Archive
+     * @param archive
+     */
+    template<class Archive>
+    void load(Archive& archive){
+        cereal::size_type size;
+        archive(cereal::make_size_tag(size));
+        clear();
+        for (cereal::size_type i = 0; i < size; i++){
+            std::pair<int,int> coordinates;
+            Tile tile;
+            archive(cereal::make_map_item(coordinates, tile));
+            // Only generated tiles are ever saved, older saves just didn't mark them
+            tile.setReady(true);
+            emplace(coordinates, tile);
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -20,4 +20,12 @@ class InvalidBoardLoad : public std::exception {
    const char* what() const noexcept override {return "Error: This board is not correctly generated!";};
 };
 
+class InvalidWorldFile : public std::exception {
+   const char* what() const noexcept override {return "Error: This world file is damaged or can't be read!";};
+};
+
+class WorldFileWriteFailed : public std::exception {
+   const char* what() const noexcept override {return "Error: The world file couldn't be written!";};
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "featureindex.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+#include "global.h"
+#include "tilescan.h"
+#include "utility.h"
+
+void FeatureIndex::update(std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+    std::vector<FeatureSite> sites;
+    forEachInMask(scanChunk(chunk, TilePattern::matching(-1, featGen.any)), [&](int index){
+        sites.push_back(FeatureSite{ChunkMap::tileCoordinates(chunkCoordinates, index), chunk.tiles[index].getFeature()});
+    });
+
+    auto [indexed, inserted] = chunks.insert(chunkCoordinates, std::vector<FeatureSite>());
+    count -= indexed->size();
+    count += sites.size();
+    *indexed = std::move(sites);
+    if (!inserted) return;
+
+    if (chunks.size() == 1){
+        lowest = chunkCoordinates;
+        highest = chunkCoordinates;
+        return;
+    }
+    lowest = std::make_pair(std::min(lowest.first, chunkCoordinates.first), std::min(lowest.second, chunkCoordinates.second));
+    highest = std::make_pair(std::max(highest.first, chunkCoordinates.first), std::max(highest.second, chunkCoordinates.second));
+}
+
+void FeatureIndex::clear(){
+    chunks.clear();
+    count = 0;
+}
+
+std::size_t FeatureIndex::size() const {return count;}
+
+std::vector<FeatureSite> FeatureIndex::nearest(std::pair<int,int> position, int feature, std::size_t limit, int maxDistance) const {
+    std::vector<std::pair<int, FeatureSite>> found;
+    auto closer = [](const std::pair<int, FeatureSite>& a, const std::pair<int, FeatureSite>& b){
+        return std::tie(a.first, a.second.coordinates) < std::tie(b.first, b.second.coordinates);
+    };
+    if (limit == 0 || maxDistance < 0 || chunks.empty()) return {};
+
+    auto center = ChunkMap::chunkCoordinates(position);
+    // Rings nearer than the indexed chunks are empty, and rings past them are too
+    int nearestRing = std::max({0, lowest.first - center.first, center.first - highest.first, lowest.second - center.second, center.second - highest.second});
+    int farthestRing = std::max({center.first - lowest.first, highest.first - center.first, center.second - lowest.second, highest.second - center.second});
+    for (int ring = nearestRing; ring <= farthestRing; ring++){
+        // Every tile of a chunk in the ring is at least this far away on one axis
+        int closest = ring == 0 ? 0 : (ring - 1)*Chunk::size + 1;
+        if (closest > maxDistance || (found.size() == limit && closest > found.back().first)) break;
+
+        for (auto& chunkCoordinates : getCoordinatesInRing(center, ring)){
+            const std::vector<FeatureSite>* sites = chunks.find(chunkCoordinates);
+            if (sites == nullptr) continue;
+            for (auto& site : *sites){
+                if (site.feature != feature && feature != featGen.any) continue;
+                int distance = std::abs(site.coordinates.first - position.first) + std::abs(site.coordinates.second - position.second);
+                if (distance <= maxDistance) found.emplace_back(distance, site);
+            }
+        }
+        if (found.size() >= limit){
+            std::sort(found.begin(), found.end(), closer);
+            found.resize(limit);
+        }
+    }
+
+    std::sort(found.begin(), found.end(), closer);
+    std::vector<FeatureSite> sites;
+    sites.reserve(found.size());
+    for (auto& [distance, site] : found) sites.push_back(site);
+    return sites;
+}
+
+std::vector<FeatureSite> FeatureIndex::within(std::pair<int,int> position, int feature, int radius) const {
+    return nearest(position, feature, std::numeric_limits<std::size_t>::max(), radius);
+}
\ No newline at end of file
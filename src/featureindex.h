@@ -0,0 +1,85 @@
+#ifndef FEATURE_INDEX
+#define FEATURE_INDEX
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "chunk.h"
+#include "flatmap.h"
+
+/**
+ * @brief A feature on the board
+ *
+ */
+struct FeatureSite{
+    /** Coordinates of the tile */
+    std::pair<int,int> coordinates;
+    /** Feature on the tile */
+    int feature;
+};
+
+/**
+ * @brief Spatial index of the features on a board, for nearest feature queries
+ *
+ * Keeps the list of features in each chunk, found with a chunk scan when the
+ * chunk is indexed, in a grid keyed by chunk coordinates. Queries walk rings
+ * of chunks outwards from a position, and stop once no tile of the next ring
+ * can be closer than what was already found. Features are rare, so this
+ * touches a few lists instead of every tile in between.
+ */
+class FeatureIndex{
+    /** Features of each indexed chunk */
+    FlatMap<std::vector<FeatureSite>> chunks;
+    /** Number of features indexed */
+    std::size_t count = 0;
+    /** Lowest chunk coordinates indexed on each axis */
+    std::pair<int,int> lowest;
+    /** Highest chunk coordinates indexed on each axis */
+    std::pair<int,int> highest;
+
+public:
+    /**
+     * @brief Index the features of a chunk, replacing whatever was indexed for it before
+     *
+     * @param chunkCoordinates Chunk coordinates
+     * @param chunk Chunk as it is now
+     */
+    void update(std::pair<int,int> chunkCoordinates, const Chunk& chunk);
+
+    /**
+     * @brief Forget every feature
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of features indexed
+     *
+     * @return Number of features
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Find the features closest to a position by Manhattan distance
+     *
+     * @param position Position to measure from
+     * @param feature Feature to look for (featGen.any for any feature)
+     * @param limit Most features to find
+     * @param maxDistance Farthest distance to look
+     * @return The features, nearest first (ties in order of coordinates)
+     */
+    std::vector<FeatureSite> nearest(std::pair<int,int> position, int feature, std::size_t limit, int maxDistance) const;
+
+    /**
+     * @brief Find every feature within a Manhattan distance of a position
+     *
+     * @param position Position to measure from
+     * @param feature Feature to look for (featGen.any for any feature)
+     * @param radius Farthest distance to look
+     * @return The features, nearest first (ties in order of coordinates)
+     */
+    std::vector<FeatureSite> within(std::pair<int,int> position, int feature, int radius) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,227 @@
+#ifndef FLAT_MAP
+#define FLAT_MAP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pack coordinates into one 64 bit key, x in the high half and y in the low half
+ *
+ * @param coordinates x,y pair of coordinates (or chunk coordinates)
+ * @return Packed key, different for every pair of coordinates
+ */
+inline std::uint64_t coordinateKey(std::pair<int,int> coordinates){
+    return (std::uint64_t(std::uint32_t(coordinates.first)) << 32) | std::uint32_t(coordinates.second);
+}
+
+/**
+ * @brief Unpack coordinates from a key made by coordinateKey
+ *
+ * @param key Packed key
+ * @return x,y pair of coordinates
+ */
+inline std::pair<int,int> keyCoordinates(std::uint64_t key){
+    return std::make_pair(int(std::int32_t(key >> 32)), int(std::int32_t(key)));
+}
+
+/**
+ * @brief Implements hashing for coordinates and chunk coordinates
+ *
+ * The packed key is run through the murmur3 finalizer, so every bit of both
+ * coordinates reaches every bit of the hash, and mirrored, diagonal and
+ * neighbouring coordinates spread as well as any others.
+ */
+struct CoordinateHash{
+    std::size_t operator()(std::pair<int,int> coordinates) const {return mix(coordinateKey(coordinates));}
+
+    /**
+     * @brief Scramble a 64 bit key (murmur3 finalizer)
+     *
+     * @param key Key to scramble
+     * @return Scrambled key
+     */
+    static std::uint64_t mix(std::uint64_t key){
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+};
+
+/**
+ * @brief Open-addressing hash map from coordinates to small values
+ *
+ * Slots hold the packed key and the value side by side in one array, sized
+ * to a power of two and kept at most half full, and collisions probe the
+ * next slot along. Every slot carries the stamp of the fill it was written
+ * in, so clearing only moves to a new stamp: it keeps all capacity and costs
+ * nothing however full the map was. Entries can't be erased one at a time,
+ * and growing moves every value, so pointers into the map only last until
+ * the next insert.
+ *
+ * @tparam T Type of value (default constructible and cheap to move)
+ */
+template<class T>
+class FlatMap{
+    struct Slot{
+        /** Packed coordinates */
+        std::uint64_t key = 0;
+        /** Fill the slot was written in (stale slots count as empty) */
+        std::uint32_t stamp = 0;
+        T value{};
+    };
+
+    /** Slots, sized to a power of two */
+    std::vector<Slot> slots;
+    /** Number of entries in the current fill */
+    std::size_t count = 0;
+    /** Stamp of the current fill */
+    std::uint32_t stamp = 1;
+
+    /**
+     * @brief Find the slot holding a key, or the empty slot it would go in
+     *
+     * @param key Packed coordinates
+     * @return Index of the slot
+     */
+    std::size_t probe(std::uint64_t key) const {
+        std::size_t mask = slots.size() - 1;
+        std::size_t i = CoordinateHash::mix(key) & mask;
+        while (slots[i].stamp == stamp && slots[i].key != key) i = (i + 1) & mask;
+        return i;
+    }
+
+    /**
+     * @brief Double the slots and reinsert every entry
+     *
+     */
+    void grow(){
+        std::vector<Slot> old(2*slots.size());
+        old.swap(slots);
+        std::uint32_t oldStamp = stamp;
+        stamp = 1;
+        for (auto& slot : old){
+            if (slot.stamp != oldStamp) continue;
+            Slot& moved = slots[probe(slot.key)];
+            moved.key = slot.key;
+            moved.stamp = stamp;
+            moved.value = std::move(slot.value);
+        }
+    }
+
+public:
+    /**
+     * @brief Create an empty map
+     *
+     * @param capacity Number of entries it holds before it first grows
+     */
+    explicit FlatMap(std::size_t capacity = 8){
+        std::size_t size = 2;
+        while (size < 2*capacity) size *= 2;
+        slots.resize(size);
+    }
+
+    /**
+     * @brief Forget every entry, keeping all capacity
+     *
+     */
+    void clear(){
+        count = 0;
+        if (++stamp == 0){
+            for (auto& slot : slots) slot.stamp = 0;
+            stamp = 1;
+        }
+    }
+
+    /**
+     * @brief Get the number of entries
+     *
+     * @return Number of entries
+     */
+    std::size_t size() const {return count;}
+
+    /**
+     * @brief Check if the map has no entries
+     *
+     * @return Whether or not the map is empty
+     */
+    bool empty() const {return count == 0;}
+
+    /**
+     * @brief Get the number of entries the map holds before it grows
+     *
+     * @return Capacity
+     */
+    std::size_t capacity() const {return slots.size()/2;}
+
+    /**
+     * @brief Find the value for some coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Pointer to the value, or nullptr if there is none
+     */
+    T* find(std::pair<int,int> coordinates){
+        Slot& slot = slots[probe(coordinateKey(coordinates))];
+        return slot.stamp == stamp ? &slot.value : nullptr;
+    }
+
+    /**
+     * @brief Find the value for some coordinates
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Pointer to the value, or nullptr if there is none
+     */
+    const T* find(std::pair<int,int> coordinates) const {
+        const Slot& slot = slots[probe(coordinateKey(coordinates))];
+        return slot.stamp == stamp ? &slot.value : nullptr;
+    }
+
+    /**
+     * @brief Check if some coordinates have a value
+     *
+     * @param coordinates x,y pair of coordinates
+     * @return Whether or not the coordinates have a value
+     */
+    bool contains(std::pair<int,int> coordinates) const {return find(coordinates) != nullptr;}
+
+    /**
+     * @brief Add a value unless the coordinates already have one
+     *
+     * @param coordinates x,y pair of coordinates
+     * @param value Value to add
+     * @return Pointer to the value for those coordinates, and whether or not it was added
+     */
+    std::pair<T*,bool> insert(std::pair<int,int> coordinates, const T& value){
+        std::uint64_t key = coordinateKey(coordinates);
+        std::size_t i = probe(key);
+        if (slots[i].stamp == stamp) return std::make_pair(&slots[i].value, false);
+        if (2*(count + 1) > slots.size()){
+            grow();
+            i = probe(key);
+        }
+        slots[i].key = key;
+        slots[i].stamp = stamp;
+        slots[i].value = value;
+        count++;
+        return std::make_pair(&slots[i].value, true);
+    }
+
+    /**
+     * @brief Call a function for every entry, in no particular order
+     *
+     * @tparam Function Callable taking coordinates and a value
+     * @param function Function to call
+     */
+    template<class Function>
+    void forEach(Function function) const {
+        for (auto& slot : slots){
+            if (slot.stamp == stamp) function(keyCoordinates(slot.key), slot.value);
+        }
+    }
+};
+
+#endif
\ No newline at end of file
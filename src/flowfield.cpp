@@ -0,0 +1,163 @@
+#include "flowfield.h"
+
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+FlowField::FlowField(const Board& board, std::pair<int,int> destination, std::pair<int,int> center, int radius, bool ignoreTravelCost)
+    : destination(destination), center(center), radius(radius), ignoreTravelCost(ignoreTravelCost){
+    auto low = ChunkMap::chunkCoordinates(std::make_pair(center.first - radius, center.second - radius));
+    auto high = ChunkMap::chunkCoordinates(std::make_pair(center.first + radius, center.second + radius));
+    for (int x = low.first; x <= high.first; x++){
+        for (int y = low.second; y <= high.second; y++){
+            FieldChunk& chunk = chunks[std::make_pair(x,y)];
+            chunk.distances.fill(-1);
+            chunk.directions.fill(noDirection);
+        }
+    }
+    update(board);
+}
+
+bool FlowField::inRegion(std::pair<int,int> coordinates) const {
+    return std::abs(coordinates.first - center.first) <= radius && std::abs(coordinates.second - center.second) <= radius;
+}
+
+std::pair<int,int> FlowField::getDestination() const {return destination;}
+
+int FlowField::update(const Board& board){
+    using Entry = std::pair<int, std::pair<int,int>>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    auto tileAt = [&](std::pair<int,int> coordinates) -> const Tile* {
+        if (!inRegion(coordinates)) return nullptr;
+        const Chunk* chunk = board.getChunk(ChunkMap::chunkCoordinates(coordinates));
+        int index = ChunkMap::localIndex(coordinates);
+        if (chunk == nullptr || !chunk->contains(index)) return nullptr;
+        return &chunk->tiles[index];
+    };
+    auto cell = [&](std::pair<int,int> coordinates) -> std::pair<FieldChunk*, int> {
+        return std::make_pair(&chunks.at(ChunkMap::chunkCoordinates(coordinates)), ChunkMap::localIndex(coordinates));
+    };
+    // Paths may pass through a tile if they can travel it, and always end on the destination
+    auto stepCost = [&](std::pair<int,int> coordinates, const Tile& tile){
+        if (ignoreTravelCost) return 1;
+        if (coordinates != destination && !tile.isTravellable()) return -1;
+        return tile.getTravelCost();
+    };
+
+    // Seed every new tile with the best of its already reached neighbours
+    int patched = 0;
+    for (auto& [chunkCoordinates, fieldChunk] : chunks){
+        const Chunk* chunk = board.getChunk(chunkCoordinates);
+        if (chunk == nullptr || chunk->present == fieldChunk.present) continue;
+
+        for (int i = 0; i < Chunk::area; i++){
+            bool isNew = chunk->contains(i) && !((fieldChunk.present[i/64] >> (i%64)) & 1);
+            std::pair<int,int> here = ChunkMap::tileCoordinates(chunkCoordinates, i);
+            if (!isNew || !inRegion(here)) continue;
+            patched++;
+
+            if (here == destination){
+                fieldChunk.distances[i] = 0;
+                fieldChunk.directions[i] = noDirection;
+                queue.emplace(0, here);
+                continue;
+            }
+            for (std::uint8_t direction = 0; direction < offsets.size(); direction++){
+                auto next = std::make_pair(here.first + offsets[direction].first, here.second + offsets[direction].second);
+                const Tile* tile = tileAt(next);
+                if (tile == nullptr) continue;
+                auto [nextChunk, nextIndex] = cell(next);
+                int cost = stepCost(next, *tile);
+                if (cost == -1 || nextChunk->distances[nextIndex] == -1) continue;
+
+                int distance = nextChunk->distances[nextIndex] + cost;
+                if (fieldChunk.distances[i] == -1 || distance < fieldChunk.distances[i]){
+                    fieldChunk.distances[i] = distance;
+                    fieldChunk.directions[i] = direction;
+                }
+            }
+            if (fieldChunk.distances[i] != -1) queue.emplace(fieldChunk.distances[i], here);
+        }
+        fieldChunk.present = chunk->present;
+    }
+
+    // Distances only shrink, so spread the improvements outwards cheapest first
+    while (!queue.empty()){
+        auto [distance, here] = queue.top();
+        queue.pop();
+        auto [hereChunk, hereIndex] = cell(here);
+        if (distance != hereChunk->distances[hereIndex]) continue;
+
+        int cost = stepCost(here, *tileAt(here));
+        if (cost == -1) continue;
+
+        for (std::uint8_t direction = 0; direction < offsets.size(); direction++){
+            auto previous = std::make_pair(here.first - offsets[direction].first, here.second - offsets[direction].second);
+            if (tileAt(previous) == nullptr) continue;
+            auto [previousChunk, previousIndex] = cell(previous);
+
+            int& previousDistance = previousChunk->distances[previousIndex];
+            if (previousDistance != -1 && previousDistance <= distance + cost) continue;
+            previousDistance = distance + cost;
+            previousChunk->directions[previousIndex] = direction;
+            queue.emplace(previousDistance, previous);
+        }
+    }
+    return patched;
+}
+
+int FlowField::distance(std::pair<int,int> coordinates) const {
+    if (!inRegion(coordinates)) return -1;
+    return chunks.at(ChunkMap::chunkCoordinates(coordinates)).distances[ChunkMap::localIndex(coordinates)];
+}
+
+std::pair<int,int> FlowField::nextStep(std::pair<int,int> coordinates) const {
+    if (!inRegion(coordinates)) return coordinates;
+    std::uint8_t direction = chunks.at(ChunkMap::chunkCoordinates(coordinates)).directions[ChunkMap::localIndex(coordinates)];
+    if (direction == noDirection) return coordinates;
+    return std::make_pair(coordinates.first + offsets[direction].first, coordinates.second + offsets[direction].second);
+}
+
+Path FlowField::pathFrom(const Board& board, std::pair<int,int> start) const {
+    Path path;
+    if (distance(start) == -1){
+        path.tilesTraversed = -1;
+        path.travelCost = -1;
+        return path;
+    }
+
+    for (auto here = start; here != destination;){
+        here = nextStep(here);
+        path.steps.push_back(here);
+        path.travelCost += board.getTile(here).getTravelCost();
+    }
+    path.tilesTraversed = path.steps.size();
+    return path;
+}
+
+const FlowField& FlowFieldCache::get(const Board& board, std::pair<int,int> destination, std::pair<int,int> center, int radius, bool ignoreTravelCost){
+    auto key = std::make_tuple(destination, center, radius, ignoreTravelCost);
+    auto field = fields.find(key);
+    if (field == fields.end()){
+        return fields.emplace(key, FlowField(board, destination, center, radius, ignoreTravelCost)).first->second;
+    }
+    field->second.update(board);
+    return field->second;
+}
+
+void FlowFieldCache::erase(std::pair<int,int> destination){
+    for (auto field = fields.begin(); field != fields.end();){
+        if (std::get<0>(field->first) == destination) field = fields.erase(field);
+        else field++;
+    }
+}
+
+void FlowFieldCache::clear(){
+    fields.clear();
+}
+
+std::size_t FlowFieldCache::size() const {
+    return fields.size();
+}
\ No newline at end of file
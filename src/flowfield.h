@@ -0,0 +1,156 @@
+#ifndef FLOW_FIELD
+#define FLOW_FIELD
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include "board.h"
+#include "chunk.h"
+
+/**
+ * @brief Distances to one destination from every tile of a square region, with the next step towards it
+ * 
+ * Built by a reverse Dijkstra search from the destination, and stored per chunk
+ * so any tile's distance or next step is read in constant time. Tiles are only
+ * ever added to a board, which can only make distances shorter, so new tiles are
+ * patched in by searching outwards from them instead of rebuilding the field.
+ * Paths follow the same rules as Board::findPath, kept inside the region.
+ */
+class FlowField{
+    /** Step taken in each direction, in the order of getAdjacentCoordinates */
+    static constexpr std::array<std::pair<int,int>, 4> offsets = {{{-1,0}, {0,-1}, {0,1}, {1,0}}};
+    /** Direction of tiles that have no next step */
+    static constexpr std::uint8_t noDirection = 4;
+
+    /**
+     * @brief Part of the field covering one chunk
+     * 
+     */
+    struct FieldChunk{
+        /** Presence mask of the board's chunk when it was last patched in */
+        std::array<std::uint64_t, Chunk::area/64> present{};
+        /** Distance to the destination, indexed by local index (-1 if unreachable) */
+        std::array<int, Chunk::area> distances;
+        /** Direction of the next step, indexed by local index */
+        std::array<std::uint8_t, Chunk::area> directions;
+    };
+
+    /** Coordinates paths lead to */
+    std::pair<int,int> destination;
+    /** Center of the region */
+    std::pair<int,int> center;
+    /** Radius of the region */
+    int radius;
+    /** Whether or not travel cost is ignored (every tile costs 1) */
+    bool ignoreTravelCost;
+    /** Parts of the field, by chunk coordinates */
+    std::unordered_map<std::pair<int,int>, FieldChunk, CoordinateHash> chunks;
+
+    /**
+     * @brief Check if some coordinates are inside the region
+     * 
+     * @param coordinates x,y pair of coordinates
+     * @return Whether or not the coordinates are inside the region
+     */
+    bool inRegion(std::pair<int,int> coordinates) const;
+
+public:
+    /**
+     * @brief Build the field for a destination over a region of the board
+     * 
+     * @param board Board to build the field on
+     * @param destination Coordinates paths lead to
+     * @param center Center of the region
+     * @param radius Radius of the region
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     */
+    FlowField(const Board& board, std::pair<int,int> destination, std::pair<int,int> center, int radius, bool ignoreTravelCost = false);
+
+    /**
+     * @brief Get the destination
+     * 
+     * @return Coordinates paths lead to
+     */
+    std::pair<int,int> getDestination() const;
+
+    /**
+     * @brief Patch in tiles generated since the field was built or last updated
+     * 
+     * @param board Board the field was built on
+     * @return Number of tiles patched in
+     */
+    int update(const Board& board);
+
+    /**
+     * @brief Get the distance from some coordinates to the destination
+     * 
+     * @param coordinates x,y pair of coordinates
+     * @return Tiles traversed or travel cost depending on ignoreTravelCost (-1 if unreachable or outside the region)
+     */
+    int distance(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Get the next step from some coordinates towards the destination
+     * 
+     * @param coordinates x,y pair of coordinates
+     * @return Coordinates of the next step (the same coordinates if at the destination or unreachable)
+     */
+    std::pair<int,int> nextStep(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Follow the field from some coordinates to the destination
+     * 
+     * @param board Board the field was built on
+     * @param start Starting position
+     * @return The path from start to the destination, or a path with -1 tiles traversed if there is none
+     */
+    Path pathFrom(const Board& board, std::pair<int,int> start) const;
+};
+
+/**
+ * @brief Keeps the flow fields of frequently used destinations
+ * 
+ * Fields are built on first use and patched with any newly generated tiles
+ * every time they are fetched again.
+ */
+class FlowFieldCache{
+    /** Fields by destination, region center, region radius and whether or not travel cost is ignored */
+    std::map<std::tuple<std::pair<int,int>, std::pair<int,int>, int, bool>, FlowField> fields;
+
+public:
+    /**
+     * @brief Get the up to date field for a destination over a region of the board
+     * 
+     * @param board Board to use
+     * @param destination Coordinates paths lead to
+     * @param center Center of the region
+     * @param radius Radius of the region
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @return Field (valid until the cache is changed)
+     */
+    const FlowField& get(const Board& board, std::pair<int,int> destination, std::pair<int,int> center, int radius, bool ignoreTravelCost = false);
+
+    /**
+     * @brief Drop every field leading to a destination
+     * 
+     * @param destination Coordinates paths lead to
+     */
+    void erase(std::pair<int,int> destination);
+
+    /**
+     * @brief Drop every field
+     * 
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of fields kept
+     * 
+     * @return Number of fields
+     */
+    std::size_t size() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <vector>
+#include "global.h"
+#include "rng.h"
+#include "utility.h"
+
+struct Generator::Region{
+    /** Lowest coordinates in the region */
+    std::pair<int,int> origin;
+    /** Side length of the region in tiles */
+    int width;
+    /** Biome of each tile */
+    std::vector<int> biomes;
+    /** Priority of the splotch that set each biome (0 if none has) */
+    std::vector<std::uint64_t> priorities;
+    /** Feature each tile picked on its own */
+    std::vector<int> ownFeatures;
+    /** Feature of each tile once cities are laid out */
+    std::vector<int> features;
+
+    Region(std::pair<int,int> origin, int width) : origin(origin), width(width),
+        biomes(width*width, -1), priorities(width*width, 0), ownFeatures(width*width, 0), features(width*width, 0){}
+
+    bool contains(std::pair<int,int> coordinates) const {
+        return coordinates.first >= origin.first && coordinates.first < origin.first + width
+            && coordinates.second >= origin.second && coordinates.second < origin.second + width;
+    }
+
+    int index(std::pair<int,int> coordinates) const {
+        return (coordinates.first - origin.first)*width + (coordinates.second - origin.second);
+    }
+
+    std::pair<int,int> coordinates(int index) const {
+        return std::make_pair(origin.first + index/width, origin.second + index%width);
+    }
+};
+
+namespace {
+    int floorDivide(int value, int divisor){
+        return (value >= 0 ? value : value - divisor + 1) / divisor;
+    }
+
+    int manhattan(std::pair<int,int> a, std::pair<int,int> b){
+        return std::abs(a.first - b.first) + std::abs(a.second - b.second);
+    }
+}
+
+Generator::Generator(int seed) : seed(seed){}
+
+Chunk Generator::generateChunk(std::pair<int,int> chunkCoordinates) const {
+    Region region(std::make_pair(chunkCoordinates.first*Chunk::size - margin, chunkCoordinates.second*Chunk::size - margin), Chunk::size + 2*margin);
+    generateBiomes(region);
+    generateFeatures(region);
+    generateCities(region);
+
+    Chunk chunk;
+    for (int i = 0; i < Chunk::area; i++){
+        int index = region.index(ChunkMap::tileCoordinates(chunkCoordinates, i));
+        Tile tile(region.biomes[index]);
+        tile.setFeature(region.features[index]);
+        tile.setReady(true);
+        chunk.set(i, tile);
+    }
+    return chunk;
+}
+
+void Generator::generateBiomes(Region& region) const {
+    struct Splotch{
+        std::pair<int,int> center;
+        int biome;
+        std::uint64_t priority;
+    };
+
+    // The nearest splotch to any tile is never further than the one anchored in its own cell
+    int reach = 2*splotchSpacing;
+    int firstCellX = floorDivide(region.origin.first - reach, splotchSpacing);
+    int lastCellX = floorDivide(region.origin.first + region.width - 1 + reach, splotchSpacing);
+    int firstCellY = floorDivide(region.origin.second - reach, splotchSpacing);
+    int lastCellY = floorDivide(region.origin.second + region.width - 1 + reach, splotchSpacing);
+
+    std::vector<Splotch> splotches;
+    splotches.reserve((lastCellX - firstCellX + 1)*(lastCellY - firstCellY + 1));
+    for (int cellX = firstCellX; cellX <= lastCellX; cellX++){
+        for (int cellY = firstCellY; cellY <= lastCellY; cellY++){
+            Rng rng(seed, std::make_pair(cellX, cellY), splotchStream);
+            Splotch splotch;
+            splotch.center = std::make_pair(cellX*splotchSpacing + rng.randInt(0, splotchSpacing - 1), cellY*splotchSpacing + rng.randInt(0, splotchSpacing - 1));
+            splotch.biome = rng.pickByProbability(tileGen.biomeChances);
+            splotch.priority = rng.next() | 1;
+            splotches.push_back(splotch);
+
+            std::pair biomeSize = std::make_pair(rng.randInt(tileGen.minBiomeSize,tileGen.maxBiomeSize),rng.randInt(tileGen.minBiomeSize,tileGen.maxBiomeSize));
+            std::pair center = splotch.center;
+            int y = tileGen.minBiomeSize;
+            for (int i = (center.first - biomeSize.first); i <= (center.first + biomeSize.first); i++){
+                if (i == center.first) y = biomeSize.second;
+                else if (i < center.first) y = rng.randInt(y,biomeSize.second);
+                else if (i > center.first) y = rng.randInt(tileGen.minBiomeSize,y);
+                for (int j = (center.second - y); j <= (center.second + y); j++){
+                    std::pair here = std::make_pair(i,j);
+                    if (!region.contains(here)) continue;
+                    int index = region.index(here);
+                    if (splotch.priority > region.priorities[index]){
+                        region.priorities[index] = splotch.priority;
+                        region.biomes[index] = splotch.biome;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int index = 0; index < region.width*region.width; index++){
+        if (region.priorities[index] != 0) continue;
+        std::pair here = region.coordinates(index);
+        const Splotch* nearest = nullptr;
+        for (auto& splotch : splotches){
+            if (nearest == nullptr) nearest = &splotch;
+            else {
+                int distance = manhattan(here, splotch.center);
+                int nearestDistance = manhattan(here, nearest->center);
+                if (distance < nearestDistance || (distance == nearestDistance && splotch.priority > nearest->priority)) nearest = &splotch;
+            }
+        }
+        region.biomes[index] = nearest->biome;
+    }
+}
+
+void Generator::generateFeatures(Region& region) const {
+    for (int index = 0; index < region.width*region.width; index++){
+        int feature = featGen.none;
+        if (Tile(region.biomes[index]).isTravellable()){ //TEMPORARY (no features on ocean or mountains yet)
+            Rng rng(seed, region.coordinates(index), featureStream);
+            if (rng.pickValue(featGen.featureChance)) feature = rng.pickByProbability(featGen.featureChances);
+        }
+        region.ownFeatures[index] = feature;
+        region.features[index] = feature;
+    }
+}
+
+int Generator::cityRadius(std::pair<int,int> coordinates) const {
+    Rng rng(seed, coordinates, cityStream);
+    int numDistricts = rng.randInt(featGen.minCityDistricts, featGen.maxCityDistricts);
+    if (numDistricts <= 1) return -1;
+    return (int)floor(ceil(sqrt(numDistricts))/2);
+}
+
+void Generator::generateCities(Region& region) const {
+    int maxCityRadius = (int)floor(ceil(sqrt(featGen.maxCityDistricts))/2);
+    auto isCity = [&region](std::pair<int,int> here){
+        return region.contains(here) && region.ownFeatures[region.index(here)] == featGen.city;
+    };
+
+    // Only cities that can reach the chunk matter, and only they have their whole neighbourhood in the region
+    int first = margin - maxCityRadius;
+    int last = region.width - 1 - first;
+    for (int index = 0; index < region.width*region.width; index++){
+        if (index/region.width < first || index/region.width > last || index%region.width < first || index%region.width > last) continue;
+        if (region.ownFeatures[index] != featGen.city) continue;
+        std::pair coordinates = region.coordinates(index);
+
+        Rng rng(seed, coordinates, cityStream);
+        int numDistricts = rng.randInt(featGen.minCityDistricts, featGen.maxCityDistricts);
+        if (numDistricts <= 1) continue;
+        int radius = (int)floor(ceil(sqrt(numDistricts))/2);
+
+        bool generateHarbour = false;
+        if (numDistricts > 2){
+            generateHarbour = true;
+            numDistricts--;
+        }
+        std::queue<int> districtsToGenerate;
+        for (int i = 0; i < numDistricts; i++){
+            if (i == 0) districtsToGenerate.push(featGen.cityMarket);
+            else districtsToGenerate.push(rng.pickByProbability(featGen.cityDistrictChances));
+        }
+
+        auto square = getCoordinatesInRadius(coordinates, radius);
+        std::vector<std::pair<int,int>> coordinatesInRadius;
+        coordinatesInRadius.reserve(square.size());
+        coordinatesInRadius.assign(square.begin(), square.end());
+        std::shuffle(coordinatesInRadius.begin(), coordinatesInRadius.end(), rng);
+
+        for (auto& here : coordinatesInRadius){
+            int hereIndex = region.index(here);
+            if (!Tile(region.biomes[hereIndex]).isTravellable() || region.ownFeatures[hereIndex] != featGen.none) continue;
+
+            bool claimed = false;
+            for (auto& other : getCoordinatesInRadius(here, maxCityRadius)){
+                if (other < coordinates && isCity(other)){
+                    int otherRadius = cityRadius(other);
+                    if (otherRadius >= 0 && std::max(std::abs(here.first - other.first), std::abs(here.second - other.second)) <= otherRadius){
+                        claimed = true;
+                        break;
+                    }
+                }
+            }
+            if (claimed) continue;
+
+            if (generateHarbour){
+                for (auto& adjacent : getAdjacentCoordinates(here)){
+                    if (region.biomes[region.index(adjacent)] == tileGen.ocean){
+                        region.features[hereIndex] = featGen.cityHarbour;
+                        generateHarbour = false;
+                        break;
+                    }
+                }
+            }
+            if (region.features[hereIndex] == featGen.none){
+                if (!districtsToGenerate.empty()){
+                    region.features[hereIndex] = districtsToGenerate.front();
+                    districtsToGenerate.pop();
+                }
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef GENERATOR
+#define GENERATOR
+
+#include <cstdint>
+#include <utility>
+#include "chunk.h"
+
+/**
+ * @brief Generates chunks of the board as a pure function of the seed
+ * 
+ * Every tile depends only on the seed and on coordinates, never on what
+ * has already been generated, so chunks can be generated in any order and
+ * on any thread and always come out the same. Biome splotches and cities
+ * that cross chunk borders are resolved from a margin generated around
+ * the chunk instead of from the neighbouring chunks.
+ */
+class Generator{
+    /** Spacing of the grid biome splotches are anchored to */
+    static constexpr int splotchSpacing = 8;
+    /** Tiles generated around a chunk so cities crossing its border resolve the same way on both sides */
+    static constexpr int margin = 4;
+    /** Independent random streams for each kind of decision */
+    enum streams {splotchStream = 1, featureStream, cityStream};
+
+    /** Biomes and features of a chunk plus its margin */
+    struct Region;
+
+    /** Seed used in generation */
+    int seed;
+
+    /**
+     * @brief Generates biomes for the region in "splotches"
+     * 
+     * Each cell of a splotchSpacing grid anchors one splotch at a random
+     * point inside it. A splotch moves a random amount in each direction
+     * (determined by min and max biome size) and covers a random number
+     * of tiles in each column. Where splotches overlap, the one with the
+     * highest random priority wins. Tiles no splotch covers take the biome
+     * of the nearest splotch.
+     * 
+     * @param region Region to fill
+     */
+    void generateBiomes(Region& region) const;
+
+    /**
+     * @brief Generates the feature each tile picks on its own
+     * 
+     * @param region Region to fill
+     */
+    void generateFeatures(Region& region) const;
+
+    /**
+     * @brief Generates districts around every city affecting the region's chunk
+     * 
+     * Cities are multi-tile and claim the free tiles around them. Where two
+     * cities could claim the same tile, the city with the lowest coordinates
+     * gets it, so each city can be laid out without knowing the others' layout.
+     * 
+     * @param region Region to fill
+     */
+    void generateCities(Region& region) const;
+
+    /**
+     * @brief Get the radius of the city at the given coordinates
+     * 
+     * @param coordinates Coordinates of a city tile
+     * @return Radius of the city's districts (-1 if it has no districts)
+     */
+    int cityRadius(std::pair<int,int> coordinates) const;
+
+public:
+    /**
+     * @brief Create a generator
+     * 
+     * @param seed Seed to use in generation
+     */
+    Generator(int seed);
+
+    /**
+     * @brief Generate every tile of a chunk
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Fully generated chunk
+     */
+    Chunk generateChunk(std::pair<int,int> chunkCoordinates) const;
+};
+
+#endif
\ No newline at end of file
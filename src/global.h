@@ -1,16 +1,17 @@
 #ifndef GLOBAL
 #define GLOBAL
 
-#include "safequeue.h"
+#include <string>
+#include "messagequeue.h"
 #include "tile.h"
 
-/** Safe Queue for status to be displayed alongside board */
-inline SafeQueue statusRows;
+/** Queue of status rows to be displayed alongside board (any thread may push through Interface::pushStatusRow, the interface pops) */
+inline MpscQueue<std::string> statusRows(64);
 
 /** Defines some useful values used in tile generation */
-inline TileGen tileGen;
+inline constexpr TileGen tileGen{};
 
 /** Defines some useful values used in feature generation */
-inline FeatureGen featGen;
+inline constexpr FeatureGen featGen{};
 
 #endif
\ No newline at end of file
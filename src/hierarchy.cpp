@@ -0,0 +1,269 @@
+#include "hierarchy.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include "global.h"
+#include "utility.h"
+
+namespace {
+    /**
+     * @brief Get a tile of the board without copying it
+     * 
+     * @param board Board to use
+     * @param coordinates x,y pair of coordinates
+     * @return Pointer to the tile, or nullptr if it doesn't exist
+     */
+    const Tile* tileAt(const Board& board, std::pair<int,int> coordinates){
+        const Chunk* chunk = board.getChunk(ChunkMap::chunkCoordinates(coordinates));
+        int index = ChunkMap::localIndex(coordinates);
+        if (chunk == nullptr || !chunk->contains(index)) return nullptr;
+        return &chunk->tiles[index];
+    }
+
+    int manhattan(std::pair<int,int> from, std::pair<int,int> to){
+        return std::abs(from.first - to.first) + std::abs(from.second - to.second);
+    }
+}
+
+PathHierarchy::PathHierarchy(bool ignoreTravelCost, int directDistance) : ignoreTravelCost(ignoreTravelCost), directDistance(directDistance){}
+
+int PathHierarchy::stepCost(const Tile& tile) const {
+    return ignoreTravelCost ? 1 : tile.getTravelCost();
+}
+
+bool PathHierarchy::passable(const Tile& tile) const {
+    return ignoreTravelCost || tile.isTravellable();
+}
+
+std::array<std::array<std::uint64_t, Chunk::area/64>, 5> PathHierarchy::presence(const Board& board, std::pair<int,int> chunkCoordinates){
+    static constexpr std::array<std::pair<int,int>, 5> offsets = {{{0,0}, {-1,0}, {1,0}, {0,-1}, {0,1}}};
+    std::array<std::array<std::uint64_t, Chunk::area/64>, 5> masks{};
+    for (std::size_t i = 0; i < offsets.size(); i++){
+        const Chunk* chunk = board.getChunk(std::make_pair(chunkCoordinates.first + offsets[i].first, chunkCoordinates.second + offsets[i].second));
+        if (chunk != nullptr) masks[i] = chunk->present;
+    }
+    return masks;
+}
+
+std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> PathHierarchy::entrances(const Board& board, std::pair<int,int> chunkCoordinates, bool alongX) const {
+    std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> found;
+    auto origin = ChunkMap::tileCoordinates(chunkCoordinates, 0);
+    auto crossing = [&](int k){
+        std::pair<int,int> inside = alongX ? std::make_pair(origin.first + Chunk::size - 1, origin.second + k) : std::make_pair(origin.first + k, origin.second + Chunk::size - 1);
+        std::pair<int,int> outside = alongX ? std::make_pair(inside.first + 1, inside.second) : std::make_pair(inside.first, inside.second + 1);
+        return std::make_pair(inside, outside);
+    };
+
+    // Each run of crossable tile pairs is one entrance, crossed at its middle
+    int runStart = -1;
+    for (int k = 0; k <= Chunk::size; k++){
+        bool open = false;
+        if (k < Chunk::size){
+            auto [inside, outside] = crossing(k);
+            const Tile* insideTile = tileAt(board, inside);
+            const Tile* outsideTile = tileAt(board, outside);
+            open = insideTile != nullptr && outsideTile != nullptr && passable(*insideTile) && passable(*outsideTile);
+        }
+        if (open && runStart == -1) runStart = k;
+        if (!open && runStart != -1){
+            found.push_back(crossing((runStart + k - 1)/2));
+            runStart = -1;
+        }
+    }
+    return found;
+}
+
+std::array<int, Chunk::area> PathHierarchy::localCosts(const Board& board, std::pair<int,int> source, bool reverse) const {
+    std::array<int, Chunk::area> costs;
+    costs.fill(-1);
+    const Chunk* chunk = board.getChunk(ChunkMap::chunkCoordinates(source));
+    int sourceIndex = ChunkMap::localIndex(source);
+    if (chunk == nullptr || !chunk->contains(sourceIndex)) return costs;
+
+    using Entry = std::pair<int,int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    costs[sourceIndex] = 0;
+    queue.emplace(0, sourceIndex);
+
+    while (!queue.empty()){
+        auto [cost, index] = queue.top();
+        queue.pop();
+        if (cost != costs[index]) continue;
+        if (index != sourceIndex && !passable(chunk->tiles[index])) continue;
+
+        int x = index/Chunk::size;
+        int y = index%Chunk::size;
+        for (auto [dx, dy] : {std::make_pair(-1,0), std::make_pair(0,-1), std::make_pair(0,1), std::make_pair(1,0)}){
+            if (x + dx < 0 || x + dx >= Chunk::size || y + dy < 0 || y + dy >= Chunk::size) continue;
+            int next = (x + dx)*Chunk::size + y + dy;
+            if (!chunk->contains(next)) continue;
+
+            // Going backwards, the step onto this tile is paid by whoever comes from next
+            int nextCost = cost + stepCost(chunk->tiles[reverse ? index : next]);
+            if (costs[next] != -1 && costs[next] <= nextCost) continue;
+            costs[next] = nextCost;
+            queue.emplace(nextCost, next);
+        }
+    }
+    return costs;
+}
+
+const PathHierarchy::Cluster& PathHierarchy::cluster(const Board& board, std::pair<int,int> chunkCoordinates){
+    auto present = presence(board, chunkCoordinates);
+    auto found = clusters.find(chunkCoordinates);
+    if (found != clusters.end() && found->second.present == present) return found->second;
+
+    Cluster& built = clusters[chunkCoordinates];
+    built.present = present;
+    built.transitions.clear();
+    built.across.clear();
+    // A corner tile can be the inside of entrances on two borders
+    auto add = [&built](std::pair<int,int> inside, std::pair<int,int> outside){
+        auto transition = std::find(built.transitions.begin(), built.transitions.end(), inside);
+        if (transition != built.transitions.end()){
+            built.across[transition - built.transitions.begin()].push_back(outside);
+            return;
+        }
+        built.transitions.push_back(inside);
+        built.across.push_back({outside});
+    };
+    for (bool alongX : {true, false}){
+        for (auto& [inside, outside] : entrances(board, chunkCoordinates, alongX)) add(inside, outside);
+        auto previous = alongX ? std::make_pair(chunkCoordinates.first - 1, chunkCoordinates.second) : std::make_pair(chunkCoordinates.first, chunkCoordinates.second - 1);
+        for (auto& [outside, inside] : entrances(board, previous, alongX)) add(inside, outside);
+    }
+
+    std::size_t count = built.transitions.size();
+    built.costs.assign(count*count, -1);
+    for (std::size_t i = 0; i < count; i++){
+        auto costs = localCosts(board, built.transitions[i], false);
+        for (std::size_t j = 0; j < count; j++) built.costs[i*count + j] = costs[ChunkMap::localIndex(built.transitions[j])];
+    }
+    return built;
+}
+
+Path PathHierarchy::findPath(const Board& board, std::pair<int,int> start, std::pair<int,int> end){
+    Path failed;
+    failed.tilesTraversed = -1;
+    failed.travelCost = -1;
+    if (tileAt(board, start) == nullptr || tileAt(board, end) == nullptr) return failed;
+    if (manhattan(start, end) <= directDistance){
+        return board.findPath(arena, start, end, ignoreTravelCost, std::numeric_limits<int>::max());
+    }
+
+    int minTravelCost = 1;
+    if (!ignoreTravelCost) minTravelCost = *std::min_element(tileGen.biomeTravelCosts.begin(), tileGen.biomeTravelCosts.end());
+    // The start and end join the entrances of their own chunk, and those of the chunk
+    // across each border they touch (which they may only be reachable from)
+    struct Join{
+        std::pair<int,int> chunkCoordinates;
+        std::pair<int,int> anchor;
+        std::array<int, Chunk::area> costs;
+    };
+    auto joins = [&](std::pair<int,int> source, bool reverse){
+        std::vector<Join> found;
+        auto sourceChunk = ChunkMap::chunkCoordinates(source);
+        found.push_back(Join{sourceChunk, source, localCosts(board, source, reverse)});
+        for (auto& next : getAdjacentCoordinates(source)){
+            const Tile* tile = tileAt(board, next);
+            if (ChunkMap::chunkCoordinates(next) == sourceChunk || tile == nullptr || !passable(*tile)) continue;
+
+            Join join{ChunkMap::chunkCoordinates(next), next, localCosts(board, next, reverse)};
+            int offset = stepCost(reverse ? *tileAt(board, source) : *tile);
+            for (auto& cost : join.costs) if (cost != -1) cost += offset;
+            found.push_back(join);
+        }
+        return found;
+    };
+    std::vector<Join> startJoins = joins(start, false);
+    std::vector<Join> endJoins = joins(end, true);
+
+    // Plan over entrances, then refine each leg of the plan
+    std::unordered_map<std::pair<int,int>, std::pair<int, std::pair<int,int>>, CoordinateHash> best;
+    using Entry = std::tuple<int, int, std::pair<int,int>>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    auto relax = [&](std::pair<int,int> here, int cost, std::pair<int,int> parent){
+        auto found = best.find(here);
+        if (found != best.end() && found->second.first <= cost) return;
+        best[here] = std::make_pair(cost, parent);
+        queue.emplace(cost + manhattan(here, end)*minTravelCost, cost, here);
+    };
+
+    best[start] = std::make_pair(0, start);
+    queue.emplace(manhattan(start, end)*minTravelCost, 0, start);
+    for (auto& startJoin : startJoins){
+        for (auto& transition : cluster(board, startJoin.chunkCoordinates).transitions){
+            int cost = startJoin.costs[ChunkMap::localIndex(transition)];
+            if (cost != -1 && transition != start) relax(transition, cost, start);
+        }
+        for (auto& endJoin : endJoins){
+            int cost = startJoin.costs[ChunkMap::localIndex(endJoin.anchor)];
+            if (endJoin.chunkCoordinates != startJoin.chunkCoordinates || cost == -1) continue;
+            relax(end, cost + endJoin.costs[ChunkMap::localIndex(endJoin.anchor)], start);
+        }
+    }
+
+    bool reached = false;
+    while (!queue.empty()){
+        auto [estimate, cost, here] = queue.top();
+        queue.pop();
+        if (cost != best.at(here).first) continue;
+        if (here == end){
+            reached = true;
+            break;
+        }
+
+        auto chunkCoordinates = ChunkMap::chunkCoordinates(here);
+        const Cluster& current = cluster(board, chunkCoordinates);
+        auto transition = std::find(current.transitions.begin(), current.transitions.end(), here);
+        if (transition == current.transitions.end()) continue;
+        std::size_t i = transition - current.transitions.begin();
+        std::size_t count = current.transitions.size();
+
+        for (std::size_t j = 0; j < count; j++){
+            if (j != i && current.costs[i*count + j] != -1) relax(current.transitions[j], cost + current.costs[i*count + j], here);
+        }
+        for (auto& across : current.across[i]) relax(across, cost + stepCost(*tileAt(board, across)), here);
+        for (auto& endJoin : endJoins){
+            int endCost = endJoin.costs[ChunkMap::localIndex(here)];
+            if (endJoin.chunkCoordinates == chunkCoordinates && endCost != -1) relax(end, cost + endCost, here);
+        }
+    }
+    if (!reached) return failed;
+
+    std::vector<std::pair<int,int>> waypoints;
+    for (auto here = end; here != start; here = best.at(here).second) waypoints.push_back(here);
+    waypoints.push_back(start);
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Refine only the legs of the plan into tiles
+    Path path;
+    for (std::size_t i = 1; i < waypoints.size(); i++){
+        auto from = waypoints[i - 1];
+        auto to = waypoints[i];
+        if (manhattan(from, to) == 1){
+            path.steps.push_back(to);
+            path.travelCost += tileAt(board, to)->getTravelCost();
+            continue;
+        }
+
+        const Path& leg = board.findPath(arena, from, to, ignoreTravelCost, best.at(to).first - best.at(from).first);
+        if (leg.tilesTraversed == -1) return failed;
+        path.steps.insert(path.steps.end(), leg.steps.begin(), leg.steps.end());
+        path.travelCost += leg.travelCost;
+    }
+    path.tilesTraversed = path.steps.size();
+    return path;
+}
+
+std::size_t PathHierarchy::size() const {
+    return clusters.size();
+}
+
+void PathHierarchy::clear(){
+    clusters.clear();
+}
\ No newline at end of file
@@ -0,0 +1,136 @@
+#ifndef HIERARCHY
+#define HIERARCHY
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "board.h"
+#include "chunk.h"
+#include "searcharena.h"
+
+/**
+ * @brief Finds long paths by searching between chunk entrances first (HPA*)
+ * 
+ * Every run of passable tiles along the border between two chunks is an
+ * entrance, crossed at its middle. Each chunk keeps the cost of travelling
+ * between its entrances without leaving it, so a long trip is planned over
+ * entrances only, and only the legs actually used are refined into tiles.
+ * Chunk data is built when first needed and rebuilt once tiles are added to
+ * the chunk or its neighbours. Paths follow the same rules as Board::findPath,
+ * but may cost slightly more than the shortest one.
+ */
+class PathHierarchy{
+    /**
+     * @brief Entrances of one chunk and the costs between them
+     * 
+     */
+    struct Cluster{
+        /** Presence masks of the chunk and its neighbours when the cluster was built */
+        std::array<std::array<std::uint64_t, Chunk::area/64>, 5> present;
+        /** Tiles of the chunk on its side of each entrance (once each, even where entrances share a corner tile) */
+        std::vector<std::pair<int,int>> transitions;
+        /** Tiles across the border from each transition, one for each entrance it is part of */
+        std::vector<std::vector<std::pair<int,int>>> across;
+        /** Cost from transition i to transition j at i*transitions.size() + j (-1 if unreachable) */
+        std::vector<int> costs;
+    };
+
+    /** Whether or not travel cost is ignored (every tile costs 1) */
+    bool ignoreTravelCost;
+    /** Routes this close or closer are searched directly */
+    int directDistance;
+    /** Clusters by chunk coordinates */
+    std::unordered_map<std::pair<int,int>, Cluster, CoordinateHash> clusters;
+    /** Search arena used to refine legs */
+    SearchArena arena;
+
+    /**
+     * @brief Get the presence masks of a chunk and its four neighbours
+     * 
+     * @param board Board to use
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Presence masks, the chunk's first
+     */
+    static std::array<std::array<std::uint64_t, Chunk::area/64>, 5> presence(const Board& board, std::pair<int,int> chunkCoordinates);
+
+    /**
+     * @brief Get the entrances along the border on the positive side of a chunk
+     * 
+     * @param board Board to use
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param alongX Whether the border is the one crossed by moving along x (otherwise along y)
+     * @return Pairs of tiles crossing each entrance, the one inside the chunk first
+     */
+    std::vector<std::pair<std::pair<int,int>, std::pair<int,int>>> entrances(const Board& board, std::pair<int,int> chunkCoordinates, bool alongX) const;
+
+    /**
+     * @brief Get the cost of every tile of a chunk from or to a source, without leaving the chunk
+     * 
+     * @param board Board to use
+     * @param source Coordinates of the source
+     * @param reverse Whether to get costs from each tile to the source (otherwise from the source)
+     * @return Costs, indexed by local index (-1 if unreachable)
+     */
+    std::array<int, Chunk::area> localCosts(const Board& board, std::pair<int,int> source, bool reverse) const;
+
+    /**
+     * @brief Get the up to date cluster of a chunk
+     * 
+     * @param board Board to use
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Cluster (valid until another is built)
+     */
+    const Cluster& cluster(const Board& board, std::pair<int,int> chunkCoordinates);
+
+    /**
+     * @brief Get the cost of travelling onto a tile
+     * 
+     * @param tile Tile travelled onto
+     * @return Cost of travelling onto the tile
+     */
+    int stepCost(const Tile& tile) const;
+
+    /**
+     * @brief Check if paths may pass through a tile
+     * 
+     * @param tile Tile to check
+     * @return Whether or not paths may pass through the tile
+     */
+    bool passable(const Tile& tile) const;
+
+public:
+    /**
+     * @brief Create an empty hierarchy
+     * 
+     * @param ignoreTravelCost Whether or not to ignore travel cost
+     * @param directDistance Routes this close or closer (in Manhattan distance) are searched directly
+     */
+    PathHierarchy(bool ignoreTravelCost = false, int directDistance = 2*Chunk::size);
+
+    /**
+     * @brief Generates a path between two coordinates
+     * 
+     * @param board Board to use
+     * @param start Starting position
+     * @param end End position
+     * @return The path from start to end, or a path with -1 tiles traversed if there is none
+     */
+    Path findPath(const Board& board, std::pair<int,int> start, std::pair<int,int> end);
+
+    /**
+     * @brief Get the number of clusters built
+     * 
+     * @return Number of clusters
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Drop every cluster
+     * 
+     */
+    void clear();
+};
+
+#endif
\ No newline at end of file
@@ -1,36 +1,166 @@
 #include "interface.h"
 
 #include <iostream>
+#include <unistd.h>
 #include "exceptions.h"
 #include "global.h"
 
+namespace {
+    /** Columns taken by each cell on the terminal (glyph and spacing) */
+    constexpr int cellWidth = 3;
+}
+
+ViewSnapshot ViewSnapshot::capture(const Board& board, std::pair<int,int> position, std::vector<std::string> status){
+    int viewSize = board.getViewSize();
+    ViewSnapshot view;
+    view.position = position;
+    view.side = viewSize/2*2 + 1;
+    view.tiles.resize(view.side*view.side);
+    view.status = std::move(status);
+    for (int row = 0; row < view.side; row++){
+        int x = position.first - viewSize/2 + row;
+        const Chunk* chunk = nullptr;
+        std::pair<int,int> chunkCoordinates;
+        for (int column = 0; column < view.side; column++){
+            std::pair here = std::make_pair(x, position.second - viewSize/2 + column);
+            // Neighbouring tiles in a row share a chunk, so it is only looked up when crossing into the next
+            if (chunk == nullptr || ChunkMap::chunkCoordinates(here) != chunkCoordinates){
+                chunkCoordinates = ChunkMap::chunkCoordinates(here);
+                chunk = board.getChunk(chunkCoordinates);
+            }
+            int index = ChunkMap::localIndex(here);
+            if (chunk == nullptr || !chunk->contains(index)) throw TileMissingException();
+            view.tiles[row*view.side + column] = chunk->tiles[index];
+        }
+    }
+    return view;
+}
+
 Interface::Interface(){
     for (int i = 0; i < statusSpacingAmount; i++) statusSpacing.append(" ");
+    cellText.push_back(playerChar + "  ");
+    for (int biome = 0; biome < TileGen::biomeCount; biome++){
+        auto glyph = biomeChars.find(biome);
+        cellText.push_back(glyph == biomeChars.end() ? "" : glyph->second + "  ");
+    }
+    for (int feature = 0; feature < FeatureGen::featureCount; feature++){
+        auto glyph = featureChars.find(feature);
+        cellText.push_back(glyph == featureChars.end() ? "" : glyph->second + "  ");
+    }
 }
 
 void Interface::setStatusSpacingAmount(int spacingAmount){
     statusSpacingAmount = spacingAmount;
-    for (int i = 0; i < statusSpacingAmount; i++) statusSpacing.append(" ");
+    statusSpacing.assign(statusSpacingAmount, ' ');
+    lastSide = 0;
 }
 
-void Interface::printGame(const Board& board, std::pair<int,int> position, bool useNewlines) const{
-    int viewSize = board.getViewSize();
-    if (useNewlines) for (int i = 0; i < 100; i++) std::cout << std::endl;
-    for (int i = (position.first - viewSize/2); i <= (position.first + viewSize/2); i++){
-        for (int j = (position.second - viewSize/2); j <= (position.second + viewSize/2); j++){
-            std::pair here = std::make_pair(i,j);
-            Tile tile = board.getTile(here);
-
-            if (here == position) std::cout << playerChar << "  ";
-            else if (tile.getFeature() != featGen.none){
-                try{std::cout << featureChars.at(tile.getFeature()) << "  ";}
-                catch(const std::exception&){throw InvalidFeatureFound();};
-            }
-            else {
-                try{std::cout << biomeChars.at(tile.getBiome()) << "  ";}
-                catch(const std::exception&){throw InvalidBiomeFound();};
+std::uint8_t Interface::cellOf(const Tile& tile) const {
+    int feature = tile.getFeature();
+    if (feature != featGen.none){
+        std::uint8_t cell = 1 + TileGen::biomeCount + feature;
+        if (feature < 0 || feature >= FeatureGen::featureCount || cellText[cell].empty()) throw InvalidFeatureFound();
+        return cell;
+    }
+    int biome = tile.getBiome();
+    if (biome < 0 || biome >= TileGen::biomeCount || cellText[1 + biome].empty()) throw InvalidBiomeFound();
+    return 1 + biome;
+}
+
+void Interface::fillCells(const ViewSnapshot& view){
+    cells.resize(view.tiles.size());
+    for (std::size_t i = 0; i < view.tiles.size(); i++) cells[i] = cellOf(view.tiles[i]);
+    // The player is always at the centre
+    if (view.side > 0) cells[view.side/2*view.side + view.side/2] = playerCell;
+}
+
+std::vector<std::string> Interface::takeStatusRows(int rows){
+    std::vector<std::string> status;
+    status.reserve(rows);
+    for (int row = 0; row < rows; row++) status.push_back(statusRows.tryPop().value_or(""));
+    return status;
+}
+
+bool Interface::pushStatusRow(std::string row){
+    return statusRows.tryPush(std::move(row));
+}
+
+void Interface::writeToTerminal(const std::string& bytes){
+    std::cout.flush();
+    for (std::size_t done = 0; done < bytes.size();){
+        ssize_t count = write(STDOUT_FILENO, bytes.data() + done, bytes.size() - done);
+        if (count <= 0) return;
+        done += count;
+    }
+}
+
+void Interface::moveTo(int row, int column){
+    frame.append("\x1b[");
+    frame.append(std::to_string(row + 1));
+    frame.push_back(';');
+    frame.append(std::to_string(column + 1));
+    frame.push_back('H');
+}
+
+const std::string& Interface::drawFrame(const Board& board, std::pair<int,int> position, const std::vector<std::string>& status){
+    return drawFrame(ViewSnapshot::capture(board, position, status));
+}
+
+const std::string& Interface::drawFrame(const ViewSnapshot& view){
+    int side = view.side;
+    const std::vector<std::string>& status = view.status;
+    fillCells(view);
+    frame.clear();
+    if (side != lastSide){
+        frame.append("\x1b[H\x1b[2J");
+        lastCells.assign(cells.size(), noCell);
+        lastStatus.assign(side, "");
+        lastSide = side;
+    }
+
+    static const std::string noStatus;
+    for (int row = 0; row < side; row++){
+        // Changed cells next to each other are written in one run, the cursor moving on by itself
+        bool cursorHere = false;
+        for (int column = 0; column < side; column++){
+            int index = row*side + column;
+            if (cells[index] == lastCells[index]){
+                cursorHere = false;
+                continue;
             }
+            if (!cursorHere) moveTo(row, column*cellWidth);
+            frame.append(cellText[cells[index]]);
+            cursorHere = true;
         }
-        std::cout << statusSpacing << statusRows.tryDequeue() << std::endl;
+        const std::string& text = std::size_t(row) < status.size() ? status[row] : noStatus;
+        if (text != lastStatus[row]){
+            moveTo(row, side*cellWidth + statusSpacingAmount);
+            frame.append(text);
+            frame.append("\x1b[K");
+            lastStatus[row] = text;
+        }
+    }
+    if (!frame.empty()) moveTo(side, 0);
+    std::swap(cells, lastCells);
+    return frame;
+}
+
+void Interface::printGame(const Board& board, std::pair<int,int> position, bool inPlace){
+    ViewSnapshot view = ViewSnapshot::capture(board, position, takeStatusRows(board.getViewSize()/2*2 + 1));
+    if (inPlace){
+        writeToTerminal(drawFrame(view));
+        return;
+    }
+
+    fillCells(view);
+    frame.clear();
+    for (int row = 0; row < view.side; row++){
+        for (int column = 0; column < view.side; column++) frame.append(cellText[cells[row*view.side + column]]);
+        frame.append(statusSpacing);
+        frame.append(view.status[row]);
+        frame.push_back('\n');
     }
+    // The terminal no longer shows the last frame drawn in place
+    lastSide = 0;
+    writeToTerminal(frame);
 }
\ No newline at end of file
@@ -1,12 +1,46 @@
 #ifndef INTERFACE
 #define INTERFACE
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
 #include "board.h"
 #include "tile.h"
 
+/**
+ * @brief Copy of everything a frame shows, so it can be drawn away from the board
+ * 
+ */
+struct ViewSnapshot{
+    /** Player position, at the centre of the view */
+    std::pair<int,int> position;
+    /** Side length of the view in tiles (0 for no view) */
+    int side = 0;
+    /** Tiles in view, row by row */
+    std::vector<Tile> tiles;
+    /** Status rows shown alongside the view, from the top */
+    std::vector<std::string> status;
+
+    /**
+     * @brief Copy the view around a position, reading tiles chunk by chunk
+     * 
+     * @param board Board to show
+     * @param position Player position
+     * @param status Status rows to show alongside the view, from the top
+     * @return Snapshot of the view
+     * @throws TileMissingException if a tile in view doesn't exist
+     */
+    static ViewSnapshot capture(const Board& board, std::pair<int,int> position, std::vector<std::string> status);
+};
+
 /**
  * @brief Interfaces between the Board, Player, and human
  * 
+ * Frames are drawn double-buffered: each frame is built as a grid of cells,
+ * compared with the last frame drawn, and only the cells and status rows that
+ * changed are sent, placed with ANSI cursor moves, in a single write. Every
+ * glyph is assumed to take one column, so each cell takes three.
  */
 class Interface{
     TileGen tileGen;
@@ -41,6 +75,48 @@ class Interface{
         {featGen.cave,"\u26CF"},
         {featGen.lake,"o"},
     };
+
+    /** Cell for the player location, other cells are tiles (see cellOf) */
+    static constexpr std::uint8_t playerCell = 0;
+    /** Cell that is never drawn, so every cell differs from it */
+    static constexpr std::uint8_t noCell = 0xFF;
+    /** Text drawn for each cell (glyph and spacing), empty for biomes and features without a glyph */
+    std::vector<std::string> cellText;
+    /** Cells of the frame being drawn, row by row */
+    std::vector<std::uint8_t> cells;
+    /** Cells of the last frame drawn */
+    std::vector<std::uint8_t> lastCells;
+    /** Status rows of the last frame drawn */
+    std::vector<std::string> lastStatus;
+    /** Side length in cells of the last frame drawn (0 if the next frame must be drawn whole) */
+    int lastSide = 0;
+    /** Bytes of the frame being drawn, kept to reuse its capacity */
+    std::string frame;
+
+    /**
+     * @brief Get the cell showing a tile
+     * 
+     * @param tile Tile to show
+     * @return Cell
+     * @throws InvalidBiomeFound if the tile's biome has no glyph
+     * @throws InvalidFeatureFound if the tile's feature has no glyph
+     */
+    std::uint8_t cellOf(const Tile& tile) const;
+
+    /**
+     * @brief Fill cells with a view
+     * 
+     * @param view View to show
+     */
+    void fillCells(const ViewSnapshot& view);
+
+    /**
+     * @brief Append a cursor move to the frame
+     * 
+     * @param row Row (from 0)
+     * @param column Column (from 0)
+     */
+    void moveTo(int row, int column);
 public:
     /**
      * @brief Construct a new Interface object (default constructor)
@@ -56,12 +132,63 @@ public:
     void setStatusSpacingAmount(int spacingAmount);
 
     /**
-     * @brief Prints a human-readable board
+     * @brief Take a status row from statusRows for each row of a view
+     * 
+     * @param rows Number of rows in the view
+     * @return Status rows (empty where statusRows ran out)
+     */
+    static std::vector<std::string> takeStatusRows(int rows);
+
+    /**
+     * @brief Add a row to statusRows, dropping it if statusRows is full
+     * 
+     * Rows are only taken a view's worth at a time, often on the thread that
+     * pushes them, so waiting for room could wait forever.
+     * 
+     * @param row Status row
+     * @return Whether or not the row was added
+     */
+    static bool pushStatusRow(std::string row);
+
+    /**
+     * @brief Write bytes to the terminal in as few syscalls as it allows
+     * 
+     * @param bytes Bytes to write
+     */
+    static void writeToTerminal(const std::string& bytes);
+
+    /**
+     * @brief Build the bytes that bring the terminal from the last frame drawn to this one
+     * 
+     * The first frame (and any frame of a different size) clears the screen
+     * and is drawn whole.
+     * 
+     * @param view View to show
+     * @return Bytes to write (empty if nothing changed), valid until the next frame
+     * @throws InvalidBiomeFound if a tile's biome has no glyph
+     * @throws InvalidFeatureFound if a tile's feature has no glyph
+     */
+    const std::string& drawFrame(const ViewSnapshot& view);
+
+    /**
+     * @brief Build the bytes that bring the terminal from the last frame drawn to the view around a position
+     * 
+     * @param board Board to show
+     * @param position Player position
+     * @param status Status rows to show alongside the board, from the top
+     * @return Bytes to write (empty if nothing changed), valid until the next frame
+     * @throws TileMissingException if a tile in view doesn't exist
+     */
+    const std::string& drawFrame(const Board& board, std::pair<int,int> position, const std::vector<std::string>& status);
+
+    /**
+     * @brief Prints a human-readable board, with a status row from statusRows beside each row
      * 
      * @param board Board to print
      * @param position Player position
+     * @param inPlace Whether to draw over the last frame on the terminal, rather than print the whole frame as plain lines
      */
-    void printGame(const Board& board, std::pair<int,int> position, bool useNewlines = true) const;
+    void printGame(const Board& board, std::pair<int,int> position, bool inPlace = true);
 };
 
 #endif
\ No newline at end of file
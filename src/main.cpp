@@ -1,15 +1,16 @@
 #include "board.h"
 #include "global.h"
 #include "interface.h"
+#include "renderer.h"
 
 int main(){
     std::pair position = std::make_pair(0,0);
-    Interface interface;
     Board board(7);
-    statusRows.enqueue("Character Name");
-    statusRows.enqueue("==============");
-    statusRows.enqueue("");
-    statusRows.enqueue("HP: 25");
-    interface.printGame(board, position);
+    Renderer renderer;
+    Interface::pushStatusRow("Character Name");
+    Interface::pushStatusRow("==============");
+    Interface::pushStatusRow("");
+    Interface::pushStatusRow("HP: 25");
+    renderer.submit(ViewSnapshot::capture(board, position, Interface::takeStatusRows(board.getViewSize()/2*2 + 1)));
     return 0;
 }
\ No newline at end of file
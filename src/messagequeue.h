@@ -0,0 +1,352 @@
+#ifndef MESSAGE_QUEUE
+#define MESSAGE_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Lets a consumer sleep until a producer signals, without producers locking while nobody sleeps
+ * 
+ * The consumer spins for a while before sleeping on a condition variable,
+ * and producers only take the mutex when they see a sleeper. The fences on
+ * both sides make sure that either the producer sees the sleeper or the
+ * sleeper sees the message, so no wakeup is lost.
+ */
+class QueueWaiter{
+    /** Number of checks before the consumer sleeps */
+    static constexpr int spins = 64;
+    std::atomic<int> sleepers{0};
+    std::mutex mutex;
+    std::condition_variable condition;
+public:
+    /**
+     * @brief Block until a condition holds
+     * 
+     * @tparam Ready Callable returning true once the wait is over
+     * @param ready Condition to wait for (only changed by producers that call notify after)
+     */
+    template<class Ready>
+    void wait(Ready ready){
+        for (int i = 0; i < spins; i++){
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+        std::unique_lock lock(mutex);
+        sleepers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, ready);
+        sleepers.fetch_sub(1);
+    }
+
+    /**
+     * @brief Wake the consumer if it is sleeping
+     * 
+     */
+    void notify(){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) == 0) return;
+        // Taking the mutex waits out a consumer between its last check and sleeping
+        {std::lock_guard lock(mutex);}
+        condition.notify_all();
+    }
+};
+
+/**
+ * @brief Storage for one message in a ring, constructed and destroyed by the queue
+ * 
+ * @tparam T Type of message
+ */
+template<class T>
+struct QueueSlot{
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* get(){return std::launder(reinterpret_cast<T*>(storage));}
+};
+
+/**
+ * @brief Round a queue capacity up to a power of two (at least 2), so indices wrap with a mask
+ * 
+ * @param capacity Requested capacity
+ * @return Capacity of the ring
+ */
+inline std::size_t ringCapacity(std::size_t capacity){
+    std::size_t rounded = 2;
+    while (rounded < capacity) rounded *= 2;
+    return rounded;
+}
+
+/**
+ * @brief Bounded lock-free queue from one producer thread to one consumer thread
+ * 
+ * A ring of slots with the producer's and consumer's indices on separate
+ * cache lines. Each side keeps a copy of the other's index and only reloads
+ * it when the ring looks full (or empty), so most pushes and pops touch no
+ * shared cache line but the slot itself. Messages are moved in and out, so
+ * move-only types work.
+ * 
+ * @tparam T Type of message
+ */
+template<class T>
+class SpscQueue{
+    static constexpr std::size_t cacheLine = 64;
+    std::size_t mask;
+    std::unique_ptr<QueueSlot<T>[]> slots;
+    /** Index of the next message to pop (only written by the consumer) */
+    alignas(cacheLine) std::atomic<std::size_t> head{0};
+    /** Consumer's copy of the tail */
+    std::size_t knownTail = 0;
+    /** Index of the next slot to push into (only written by the producer) */
+    alignas(cacheLine) std::atomic<std::size_t> tail{0};
+    /** Producer's copy of the head */
+    std::size_t knownHead = 0;
+    alignas(cacheLine) QueueWaiter waiter;
+
+    bool ready(){
+        return tail.load(std::memory_order_acquire) != head.load(std::memory_order_relaxed);
+    }
+public:
+    /**
+     * @brief Create an empty queue
+     * 
+     * @param capacity Number of messages the queue holds before pushes fail (rounded up to a power of two)
+     */
+    explicit SpscQueue(std::size_t capacity) : mask(ringCapacity(capacity) - 1), slots(new QueueSlot<T>[mask + 1]){}
+
+    ~SpscQueue(){while (tryPop());}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Get the number of messages the queue holds
+     * 
+     * @return Capacity
+     */
+    std::size_t capacity() const {return mask + 1;}
+
+    /**
+     * @brief Push a message if there is room (producer only)
+     * 
+     * @param message Message to push, left untouched if the queue is full
+     * @return Whether the message was pushed
+     */
+    bool tryPush(T&& message){
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        if (position - knownHead > mask){
+            knownHead = head.load(std::memory_order_acquire);
+            if (position - knownHead > mask) return false;
+        }
+        new (slots[position & mask].storage) T(std::move(message));
+        tail.store(position + 1, std::memory_order_release);
+        waiter.notify();
+        return true;
+    }
+
+    /**
+     * @brief Push a message, yielding while the queue is full (producer only)
+     * 
+     * @param message Message to push
+     */
+    void push(T&& message){
+        while (!tryPush(std::move(message))) std::this_thread::yield();
+    }
+
+    /**
+     * @brief Pop the oldest message if there is one (consumer only)
+     * 
+     * @return The message, or nothing if the queue is empty
+     */
+    std::optional<T> tryPop(){
+        std::size_t position = head.load(std::memory_order_relaxed);
+        if (position == knownTail){
+            knownTail = tail.load(std::memory_order_acquire);
+            if (position == knownTail) return std::nullopt;
+        }
+        T* message = slots[position & mask].get();
+        std::optional<T> popped(std::move(*message));
+        message->~T();
+        head.store(position + 1, std::memory_order_release);
+        return popped;
+    }
+
+    /**
+     * @brief Pop the oldest message, sleeping until one is pushed (consumer only)
+     * 
+     * @return The message
+     */
+    T pop(){
+        waiter.wait([this]{return ready();});
+        return std::move(*tryPop());
+    }
+
+    /**
+     * @brief Pop every message pushed so far in one pass, handing each to a function (consumer only)
+     * 
+     * The consumer's index is published once for the whole batch.
+     * 
+     * @tparam Function Callable taking a T&&
+     * @param function Function called with each message, oldest first
+     * @param limit Most messages to pop
+     * @return Number of messages popped
+     */
+    template<class Function>
+    std::size_t drain(Function function, std::size_t limit = std::numeric_limits<std::size_t>::max()){
+        std::size_t position = head.load(std::memory_order_relaxed);
+        knownTail = tail.load(std::memory_order_acquire);
+        std::size_t count = std::min(knownTail - position, limit);
+        for (std::size_t i = 0; i < count; i++){
+            T* message = slots[(position + i) & mask].get();
+            function(std::move(*message));
+            message->~T();
+        }
+        head.store(position + count, std::memory_order_release);
+        return count;
+    }
+};
+
+/**
+ * @brief Bounded lock-free queue from any number of producer threads to one consumer thread
+ * 
+ * A ring of slots that each carry a sequence number saying whether the slot
+ * is free for the push at an index, or holds the message for the pop at that
+ * index. Producers claim an index with a compare and swap on the tail, then
+ * publish the message through its slot's sequence, so producers only contend
+ * on the tail. Messages are moved in and out, so move-only types work.
+ * 
+ * @tparam T Type of message
+ */
+template<class T>
+class MpscQueue{
+    static constexpr std::size_t cacheLine = 64;
+    struct Slot{
+        std::atomic<std::size_t> sequence;
+        QueueSlot<T> message;
+    };
+    std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    /** Index of the next message to pop (only used by the consumer) */
+    alignas(cacheLine) std::size_t head = 0;
+    /** Index of the next slot to claim */
+    alignas(cacheLine) std::atomic<std::size_t> tail{0};
+    alignas(cacheLine) QueueWaiter waiter;
+
+    bool ready(){
+        return slots[head & mask].sequence.load(std::memory_order_acquire) == head + 1;
+    }
+public:
+    /**
+     * @brief Create an empty queue
+     * 
+     * @param capacity Number of messages the queue holds before pushes fail (rounded up to a power of two)
+     */
+    explicit MpscQueue(std::size_t capacity) : mask(ringCapacity(capacity) - 1), slots(new Slot[mask + 1]){
+        for (std::size_t i = 0; i <= mask; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpscQueue(){while (tryPop());}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Get the number of messages the queue holds
+     * 
+     * @return Capacity
+     */
+    std::size_t capacity() const {return mask + 1;}
+
+    /**
+     * @brief Push a message if there is room (any thread)
+     * 
+     * @param message Message to push, left untouched if the queue is full
+     * @return Whether the message was pushed
+     */
+    bool tryPush(T&& message){
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true){
+            slot = &slots[position & mask];
+            auto difference = std::intptr_t(slot->sequence.load(std::memory_order_acquire) - position);
+            if (difference == 0){
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if (difference < 0) return false;
+            else position = tail.load(std::memory_order_relaxed);
+        }
+        new (slot->message.storage) T(std::move(message));
+        slot->sequence.store(position + 1, std::memory_order_release);
+        waiter.notify();
+        return true;
+    }
+
+    /**
+     * @brief Push a message, yielding while the queue is full (any thread)
+     * 
+     * @param message Message to push
+     */
+    void push(T&& message){
+        while (!tryPush(std::move(message))) std::this_thread::yield();
+    }
+
+    /**
+     * @brief Pop the oldest message if there is one (consumer only)
+     * 
+     * A producer that has claimed a slot but not yet filled it holds back the messages pushed after it.
+     * 
+     * @return The message, or nothing if the queue is empty
+     */
+    std::optional<T> tryPop(){
+        if (!ready()) return std::nullopt;
+        Slot& slot = slots[head & mask];
+        T* message = slot.message.get();
+        std::optional<T> popped(std::move(*message));
+        message->~T();
+        slot.sequence.store(head + mask + 1, std::memory_order_release);
+        head++;
+        return popped;
+    }
+
+    /**
+     * @brief Pop the oldest message, sleeping until one is pushed (consumer only)
+     * 
+     * @return The message
+     */
+    T pop(){
+        waiter.wait([this]{return ready();});
+        return std::move(*tryPop());
+    }
+
+    /**
+     * @brief Pop every message ready so far in one pass, handing each to a function (consumer only)
+     * 
+     * @tparam Function Callable taking a T&&
+     * @param function Function called with each message, oldest first
+     * @param limit Most messages to pop
+     * @return Number of messages popped
+     */
+    template<class Function>
+    std::size_t drain(Function function, std::size_t limit = std::numeric_limits<std::size_t>::max()){
+        std::size_t count = 0;
+        for (; count < limit && ready(); count++){
+            Slot& slot = slots[head & mask];
+            T* message = slot.message.get();
+            function(std::move(*message));
+            message->~T();
+            slot.sequence.store(head + mask + 1, std::memory_order_release);
+            head++;
+        }
+        return count;
+    }
+};
+
+#endif
\ No newline at end of file
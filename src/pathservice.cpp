@@ -0,0 +1,70 @@
+#include "pathservice.h"
+
+#include <algorithm>
+#include "searcharena.h"
+
+namespace {
+    /** Scratch space of each worker */
+    thread_local SearchArena workerArena;
+}
+
+PathService::PathService(int threads) : pool(threads){}
+
+std::shared_ptr<const Board> PathService::snapshot(const Board& board){
+    return std::make_shared<const Board>(board);
+}
+
+const Path& PathService::run(const Board& board, const PathRequest& request){
+    return board.pathTo(workerArena, request.start, request.biome, request.feature, request.ignoreTravelCost, request.maxDistance, request.toSkip, request.end);
+}
+
+void PathService::dispatch(std::size_t count, std::function<void(std::size_t)> run){
+    // A few tasks per worker keeps them busy without queueing one task per query
+    std::size_t tasks = std::min<std::size_t>(count, 4*pool.size());
+    for (std::size_t task = 0; task < tasks; task++){
+        std::size_t first = count*task/tasks;
+        std::size_t last = count*(task + 1)/tasks;
+        pool.submit([run, first, last]{
+            for (std::size_t i = first; i < last; i++) run(i);
+        });
+    }
+}
+
+std::vector<std::future<Path>> PathService::submit(std::shared_ptr<const Board> board, std::vector<PathRequest> requests){
+    auto promises = std::make_shared<std::vector<std::promise<Path>>>(requests.size());
+    std::vector<std::future<Path>> futures;
+    futures.reserve(requests.size());
+    for (auto& promise : *promises) futures.push_back(promise.get_future());
+
+    auto shared = std::make_shared<const std::vector<PathRequest>>(std::move(requests));
+    dispatch(shared->size(), [board, shared, promises](std::size_t i){
+        try {
+            (*promises)[i].set_value(run(*board, (*shared)[i]));
+        }
+        catch (...){
+            (*promises)[i].set_exception(std::current_exception());
+        }
+    });
+    return futures;
+}
+
+void PathService::submit(std::shared_ptr<const Board> board, std::vector<PathRequest> requests, Callback onComplete, ErrorCallback onError){
+    auto shared = std::make_shared<const std::vector<PathRequest>>(std::move(requests));
+    dispatch(shared->size(), [board, shared, onComplete, onError](std::size_t i){
+        try {
+            onComplete(i, run(*board, (*shared)[i]));
+        }
+        catch (...){
+            // Nothing waits on the task, so an error escaping here would skip the rest of its queries unseen
+            if (!onError) return;
+            try {
+                onError(i, std::current_exception());
+            }
+            catch (...){}
+        }
+    });
+}
+
+int PathService::size() const {
+    return pool.size();
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#ifndef PATH_SERVICE
+#define PATH_SERVICE
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "board.h"
+#include "threadpool.h"
+
+/**
+ * @brief Construct used to describe one pathTo query
+ * 
+ */
+struct PathRequest{
+    /** Starting position */
+    std::pair<int,int> start = std::make_pair(0,0);
+    /** Biome to look for (-1 to ignore) */
+    int biome = -1;
+    /** Feature to look for (-1 to ignore) */
+    int feature = -1;
+    /** Whether or not to ignore travel cost */
+    bool ignoreTravelCost = true;
+    /** Maximum distance to search (implemented as tiles or travel cost depending on ignoreTravelCost) */
+    int maxDistance = 25;
+    /** How many matches to ignore (does nothing if coordinates specified) */
+    int toSkip = 0;
+    /** End position (if coordinates are known) */
+    std::pair<int,int> end = std::make_pair(0,0);
+};
+
+/**
+ * @brief Answers batches of path queries on a pool of worker threads
+ * 
+ * Queries run against a read-only snapshot of the board, so the board itself
+ * can keep generating while they run. Each worker searches with its own
+ * thread-local search arena.
+ */
+class PathService{
+    /** Workers running the queries */
+    ThreadPool pool;
+
+    /**
+     * @brief Split a batch over the workers
+     * 
+     * @param count Number of queries in the batch
+     * @param run Called with the index of each query, on a worker
+     */
+    void dispatch(std::size_t count, std::function<void(std::size_t)> run);
+
+public:
+    /** Called with the index of a query and its path, on the worker that ran it */
+    using Callback = std::function<void(std::size_t index, const Path& path)>;
+    /** Called with the index of a query and what it threw, on the worker that ran it */
+    using ErrorCallback = std::function<void(std::size_t index, std::exception_ptr error)>;
+
+    /**
+     * @brief Start the workers
+     * 
+     * @param threads Number of workers (0 to use one per hardware thread)
+     */
+    PathService(int threads = 0);
+
+    /**
+     * @brief Take a read-only snapshot of a board to run queries against
+     * 
+     * This is a deep copy of the whole board (every chunk, the feature index
+     * and the save bookkeeping), so it costs as much as the board is big, not
+     * as much as the queries run on it. Share one snapshot between batches for
+     * as long as the board hasn't changed in ways the queries care about.
+     * 
+     * @param board Board to copy
+     * @return Snapshot, which can be shared by any number of batches
+     */
+    static std::shared_ptr<const Board> snapshot(const Board& board);
+
+    /**
+     * @brief Run a single query on the calling thread's search arena
+     * 
+     * @param board Board to search
+     * @param request Query to run
+     * @return The path found by Board::pathTo (valid until the thread's next query)
+     */
+    static const Path& run(const Board& board, const PathRequest& request);
+
+    /**
+     * @brief Queue a batch of queries
+     * 
+     * @param board Snapshot to search
+     * @param requests Queries to run
+     * @return Futures holding the path of each query, in the order of the queries
+     */
+    std::vector<std::future<Path>> submit(std::shared_ptr<const Board> board, std::vector<PathRequest> requests);
+
+    /**
+     * @brief Queue a batch of queries, reporting each path as soon as it is found
+     * 
+     * A query that throws (in the search or in onComplete) is reported to
+     * onError instead, and the rest of the batch still runs.
+     * 
+     * @param board Snapshot to search
+     * @param requests Queries to run
+     * @param onComplete Called once for each query that succeeds (may be called from several workers at once)
+     * @param onError Called once for each query that throws (errors are dropped if empty)
+     */
+    void submit(std::shared_ptr<const Board> board, std::vector<PathRequest> requests, Callback onComplete, ErrorCallback onError = nullptr);
+
+    /**
+     * @brief Get the number of workers
+     * 
+     * @return Number of workers
+     */
+    int size() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "renderer.h"
+
+#include <algorithm>
+#include <memory>
+
+Renderer::Renderer(Interface interface, int framesPerSecond, std::function<void(const std::string&)> output)
+    : interface(std::move(interface)), output(std::move(output)), period(std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max(framesPerSecond, 1)){
+    worker = std::thread(&Renderer::work, this);
+}
+
+Renderer::~Renderer(){
+    stopping = true;
+    waiter.notify();
+    worker.join();
+}
+
+void Renderer::work(){
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (true){
+        waiter.wait([this]{return stopping || newest.load(std::memory_order_acquire) != nullptr;});
+        // Snapshots submitted until the frame is due take the place of this one, the last frame isn't held back
+        if (!stopping) std::this_thread::sleep_until(nextFrame);
+        std::unique_ptr<ViewSnapshot> view(newest.exchange(nullptr, std::memory_order_acq_rel));
+        if (view == nullptr){
+            if (stopping) return;
+            continue;
+        }
+
+        try {
+            output(interface.drawFrame(*view));
+            drawn++;
+        }
+        catch (...){
+            std::lock_guard lock(errorMutex);
+            error = std::current_exception();
+        }
+        nextFrame = std::chrono::steady_clock::now() + period;
+    }
+}
+
+void Renderer::submit(ViewSnapshot view){
+    {
+        std::lock_guard lock(errorMutex);
+        if (error != nullptr){
+            std::exception_ptr failure = error;
+            error = nullptr;
+            std::rethrow_exception(failure);
+        }
+    }
+    if (view.side == 0) return;
+    std::unique_ptr<ViewSnapshot> replaced(newest.exchange(new ViewSnapshot(std::move(view)), std::memory_order_acq_rel));
+    if (replaced != nullptr) dropped++;
+    waiter.notify();
+}
+
+int Renderer::framesDrawn() const {return drawn;}
+
+int Renderer::framesDropped() const {return dropped;}
\ No newline at end of file
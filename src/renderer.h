@@ -0,0 +1,94 @@
+#ifndef RENDERER
+#define RENDERER
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "interface.h"
+#include "messagequeue.h"
+
+/**
+ * @brief Draws frames on a background thread, so terminal output never holds up the simulation
+ * 
+ * The thread that owns the board captures view snapshots and submits them,
+ * which never blocks: a submitted snapshot takes the place of any snapshot
+ * still waiting with one atomic exchange. The background thread draws at most
+ * one frame per frame period, always from the newest snapshot, so under
+ * backpressure frames are coalesced rather than queued up. Like the Streamer,
+ * the background thread never touches the Board.
+ */
+class Renderer{
+    /** Interface that draws the frames (only used by the background thread) */
+    Interface interface;
+    /** Called on the background thread with the bytes of every frame drawn */
+    std::function<void(const std::string&)> output;
+    /** Shortest time between frames */
+    std::chrono::nanoseconds period;
+    /** Newest snapshot waiting to be drawn (owned, nullptr if none) */
+    std::atomic<ViewSnapshot*> newest{nullptr};
+    /** Wakes the background thread when a snapshot is submitted or the renderer stops */
+    QueueWaiter waiter;
+    /** Set once the renderer stops */
+    std::atomic<bool> stopping{false};
+    std::atomic<int> drawn{0};
+    std::atomic<int> dropped{0};
+    /** Why the last frame failed to draw (if it did and nobody has been told yet) */
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    std::thread worker;
+
+    /**
+     * @brief Draws the newest snapshot every frame period until the renderer stops
+     * 
+     */
+    void work();
+
+public:
+    /**
+     * @brief Start the background thread
+     * 
+     * @param interface Interface to draw frames with
+     * @param framesPerSecond Most frames to draw each second
+     * @param output Where the bytes of each frame go (the terminal by default)
+     */
+    Renderer(Interface interface = Interface(), int framesPerSecond = 30, std::function<void(const std::string&)> output = Interface::writeToTerminal);
+
+    /**
+     * @brief Draw the newest snapshot still waiting, then stop and join the background thread
+     * 
+     */
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    /**
+     * @brief Hand a snapshot to the background thread to draw, without waiting
+     * 
+     * Replaces the snapshot still waiting to be drawn, if there is one.
+     * 
+     * @param view Snapshot to draw (ignored if empty)
+     * @throws InvalidBiomeFound or InvalidFeatureFound if an earlier frame failed to draw
+     */
+    void submit(ViewSnapshot view);
+
+    /**
+     * @brief Get the number of frames drawn
+     * 
+     * @return Number of frames drawn
+     */
+    int framesDrawn() const;
+
+    /**
+     * @brief Get the number of snapshots replaced by newer ones before being drawn
+     * 
+     * @return Number of snapshots not drawn
+     */
+    int framesDropped() const;
+};
+
+#endif
\ No newline at end of file
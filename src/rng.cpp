@@ -0,0 +1,36 @@
+#include "rng.h"
+
+Rng::Rng(std::uint64_t seed) : key(mix(seed)){}
+
+Rng::Rng(std::uint64_t seed, std::pair<int,int> coordinates, std::uint64_t stream){
+    key = mix(seed ^ mix(stream));
+    key = mix(key ^ std::uint32_t(coordinates.first));
+    key = mix(key ^ (std::uint64_t(std::uint32_t(coordinates.second)) << 32));
+}
+
+std::uint64_t Rng::mix(std::uint64_t value){
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+std::uint64_t Rng::next(){
+    return mix(key + 0x9e3779b97f4a7c15ULL * ++counter);
+}
+
+Rng::result_type Rng::operator()(){return next();}
+
+int Rng::randInt(int min, int max){
+    if (max <= min) return min;
+    std::uint64_t range = std::uint64_t(std::int64_t(max) - min) + 1;
+    return int(std::int64_t(min) + std::int64_t(next() % range));
+}
+
+double Rng::randDouble(){
+    return (next() >> 11) * 0x1.0p-53;
+}
+
+bool Rng::pickValue(double probability){
+    return probability > randDouble();
+}
\ No newline at end of file
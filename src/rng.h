@@ -0,0 +1,115 @@
+#ifndef RNG
+#define RNG
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include "tile.h"
+
+/**
+ * @brief Deterministic random number generator used in world generation
+ * 
+ * Counter-based splitmix64 generator. Every stream is keyed from the
+ * board seed and a pair of coordinates, so the numbers drawn for a region
+ * never depend on what was drawn before, or on which thread draws them.
+ * Never touches the C library RNG.
+ */
+class Rng{
+    /** Key of the stream, derived from the seed and coordinates */
+    std::uint64_t key;
+    /** Number of values drawn so far */
+    std::uint64_t counter = 0;
+public:
+    /** Type returned by the generator (required by std::shuffle) */
+    using result_type = std::uint64_t;
+
+    /**
+     * @brief Create a generator with a single seed
+     * 
+     * @param seed Seed of the stream
+     */
+    explicit Rng(std::uint64_t seed);
+
+    /**
+     * @brief Create a generator for a region of the board
+     * 
+     * @param seed Seed of the board
+     * @param coordinates x,y pair of coordinates identifying the region
+     * @param stream Independent stream to draw from for the same region
+     */
+    Rng(std::uint64_t seed, std::pair<int,int> coordinates, std::uint64_t stream = 0);
+
+    /**
+     * @brief Scramble a 64 bit value (splitmix64 finalizer)
+     * 
+     * @param value Value to scramble
+     * @return Scrambled value
+     */
+    static std::uint64_t mix(std::uint64_t value);
+
+    /**
+     * @brief Get the next value in the stream
+     * 
+     * @return Uniformly distributed 64 bit value
+     */
+    std::uint64_t next();
+
+    /**
+     * @brief Get the next value in the stream (required by std::shuffle)
+     * 
+     * @return Uniformly distributed 64 bit value
+     */
+    result_type operator()();
+
+    /**
+     * @brief Smallest value the generator returns
+     * 
+     * @return 0
+     */
+    static constexpr result_type min(){return 0;}
+
+    /**
+     * @brief Largest value the generator returns
+     * 
+     * @return Largest 64 bit value
+     */
+    static constexpr result_type max(){return std::numeric_limits<result_type>::max();}
+
+    /**
+     * @brief Generates a random integer between min and max
+     * 
+     * @param min Smallest possible return value
+     * @param max Largest possible return value
+     * @return Randomly chosen int
+     */
+    int randInt(int min, int max);
+
+    /**
+     * @brief Generates a random double in [0,1)
+     * 
+     * @return Randomly chosen double
+     */
+    double randDouble();
+
+    /**
+     * @brief Picks a value (or doesn't) based on probability
+     * 
+     * @param probability The probability to pick a value
+     * @return Whether or not the value was picked
+     */
+    bool pickValue(double probability);
+
+    /**
+     * @brief Pick a key from the table based on its chance
+     * 
+     * @tparam N Number of keys in the table
+     * @param table Table to pick from
+     * @return Key returned 
+     */
+    template<std::size_t N>
+    int pickByProbability(const ChanceTable<N>& table){
+        return table.pick(randDouble());
+    }
+};
+
+#endif
\ No newline at end of file
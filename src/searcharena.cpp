@@ -0,0 +1,67 @@
+#include "searcharena.h"
+
+#include <algorithm>
+#include <functional>
+
+SearchArena::SearchArena() : byCoordinates(32){}
+
+void SearchArena::clear(){
+    nodes.clear();
+    byCoordinates.clear();
+    heap.clear();
+    fifo.clear();
+    fifoHead = 0;
+}
+
+int SearchArena::size() const {return nodes.size();}
+
+int SearchArena::find(std::pair<int,int> coordinates) const {
+    const int* node = byCoordinates.find(coordinates);
+    return node == nullptr ? -1 : *node;
+}
+
+std::pair<int,bool> SearchArena::insert(const Node& node){
+    auto [index, inserted] = byCoordinates.insert(node.coordinates, nodes.size());
+    if (inserted) nodes.push_back(node);
+    return std::make_pair(*index, inserted);
+}
+
+SearchArena::Node& SearchArena::node(int index){return nodes[index];}
+
+const SearchArena::Node& SearchArena::node(int index) const {return nodes[index];}
+
+void SearchArena::push(int estimate, int cost, int index){
+    heap.emplace_back(estimate, -cost, index);
+    std::push_heap(heap.begin(), heap.end(), std::greater<std::tuple<int,int,int>>());
+}
+
+std::tuple<int,int,int> SearchArena::pop(){
+    std::pop_heap(heap.begin(), heap.end(), std::greater<std::tuple<int,int,int>>());
+    auto [estimate, negativeCost, index] = heap.back();
+    heap.pop_back();
+    return std::make_tuple(estimate, -negativeCost, index);
+}
+
+bool SearchArena::heapEmpty() const {return heap.empty();}
+
+void SearchArena::enqueue(int index){fifo.push_back(index);}
+
+int SearchArena::dequeue(){return fifo[fifoHead++];}
+
+bool SearchArena::fifoEmpty() const {return fifoHead == fifo.size();}
+
+const Path& SearchArena::finish(int index){
+    result.steps.clear();
+    for (int i = index; nodes[i].parent != -1; i = nodes[i].parent) result.steps.push_back(nodes[i].coordinates);
+    std::reverse(result.steps.begin(), result.steps.end());
+    result.tilesTraversed = result.steps.size();
+    result.travelCost = nodes[index].travelCost;
+    return result;
+}
+
+const Path& SearchArena::fail(){
+    result.steps.clear();
+    result.tilesTraversed = -1;
+    result.travelCost = -1;
+    return result;
+}
\ No newline at end of file
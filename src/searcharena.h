@@ -0,0 +1,164 @@
+#ifndef SEARCH_ARENA
+#define SEARCH_ARENA
+
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "board.h"
+#include "flatmap.h"
+
+/**
+ * @brief Reusable workspace for searches over the board
+ * 
+ * Holds every node of a search in one flat array, each node pointing at
+ * its parent by index, plus a flat index from coordinates to nodes and the
+ * frontier. Clearing keeps all capacity, so a search run on an arena that
+ * has already seen one as large allocates nothing.
+ */
+class SearchArena{
+public:
+    /**
+     * @brief State of one searched tile
+     * 
+     */
+    struct Node{
+        /** Coordinates of the tile */
+        std::pair<int,int> coordinates;
+        /** Index of the node this one was reached from (-1 for the start) */
+        int parent;
+        /** The tiles traversed to get here */
+        int tilesTraversed;
+        /** The cost of travelling here */
+        int travelCost;
+    };
+
+private:
+    /** Every node of the current search */
+    std::vector<Node> nodes;
+    /** Index of coordinates to nodes */
+    FlatMap<int> byCoordinates;
+    /** Frontier ordered by (estimate, -cost, node), as a min-heap */
+    std::vector<std::tuple<int,int,int>> heap;
+    /** Frontier in discovery order */
+    std::vector<int> fifo;
+    /** Next node to take from the fifo */
+    std::size_t fifoHead = 0;
+    /** Path built by the last search */
+    Path result;
+
+public:
+    /**
+     * @brief Create an empty arena
+     * 
+     */
+    SearchArena();
+
+    /**
+     * @brief Forget the current search, keeping all capacity
+     * 
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of nodes in the current search
+     * 
+     * @return Number of nodes
+     */
+    int size() const;
+
+    /**
+     * @brief Find the node for some coordinates
+     * 
+     * @param coordinates x,y pair of coordinates
+     * @return Index of the node, or -1 if there is none
+     */
+    int find(std::pair<int,int> coordinates) const;
+
+    /**
+     * @brief Add a node unless its coordinates already have one
+     * 
+     * @param node Node to add
+     * @return Index of the node for those coordinates, and whether or not it was added
+     */
+    std::pair<int,bool> insert(const Node& node);
+
+    /**
+     * @brief Get a node
+     * 
+     * @param index Index of the node
+     * @return Node
+     */
+    Node& node(int index);
+
+    /**
+     * @brief Get a node
+     * 
+     * @param index Index of the node
+     * @return Node
+     */
+    const Node& node(int index) const;
+
+    /**
+     * @brief Add a node to the cost-ordered frontier
+     * 
+     * @param estimate Estimated total cost through the node
+     * @param cost Cost of reaching the node
+     * @param index Index of the node
+     */
+    void push(int estimate, int cost, int index);
+
+    /**
+     * @brief Take the cheapest entry from the cost-ordered frontier
+     * 
+     * Ties in estimate go to the entry with the highest cost so far,
+     * which is the one closest to the end.
+     * 
+     * @return Estimate, cost and node index of the entry
+     */
+    std::tuple<int,int,int> pop();
+
+    /**
+     * @brief Check if the cost-ordered frontier is empty
+     * 
+     * @return Whether or not the frontier is empty
+     */
+    bool heapEmpty() const;
+
+    /**
+     * @brief Add a node to the discovery-ordered frontier
+     * 
+     * @param index Index of the node
+     */
+    void enqueue(int index);
+
+    /**
+     * @brief Take the oldest node from the discovery-ordered frontier
+     * 
+     * @return Index of the node
+     */
+    int dequeue();
+
+    /**
+     * @brief Check if the discovery-ordered frontier is empty
+     * 
+     * @return Whether or not the frontier is empty
+     */
+    bool fifoEmpty() const;
+
+    /**
+     * @brief Build the path to a node by following parents back to the start
+     * 
+     * @param index Index of the last node of the path
+     * @return Path from the start to the node (owned by the arena)
+     */
+    const Path& finish(int index);
+
+    /**
+     * @brief Build a path marking that nothing was found
+     * 
+     * @return Path with -1 tiles traversed and -1 travel cost (owned by the arena)
+     */
+    const Path& fail();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "streamer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+Streamer::Streamer(const Board& board, int lookahead) : generator(board.getSeed()), lookahead(lookahead){
+    worker = std::thread(&Streamer::work, this);
+}
+
+Streamer::~Streamer(){
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    requested.notify_all();
+    worker.join();
+}
+
+void Streamer::work(){
+    std::unique_lock lock(mutex);
+    while (true){
+        requested.wait(lock, [this]{return stopping || !requests.empty();});
+        if (stopping) return;
+
+        std::pop_heap(requests.begin(), requests.end());
+        std::pair chunkCoordinates = requests.back().chunkCoordinates;
+        requests.pop_back();
+
+        lock.unlock();
+        Chunk chunk = generator.generateChunk(chunkCoordinates);
+        lock.lock();
+
+        completed.emplace_back(chunkCoordinates, chunk);
+        generated.notify_all();
+    }
+}
+
+void Streamer::queue(const Board& board, std::pair<int,int> chunkCoordinates, int priority){
+    if (inFlight.count(chunkCoordinates)){
+        // Queued chunks can be asked for sooner, chunks being generated are already as soon as they can be
+        for (auto& request : requests){
+            if (request.chunkCoordinates == chunkCoordinates) request.priority = std::min(request.priority, priority);
+        }
+        return;
+    }
+    if (board.chunkGenerated(chunkCoordinates)) return;
+    inFlight.insert(chunkCoordinates);
+    requests.push_back(Request{priority, chunkCoordinates});
+}
+
+void Streamer::setOnChunkReady(std::function<void(std::pair<int,int>)> callback){
+    onChunkReady = callback;
+}
+
+void Streamer::follow(const Board& board, std::pair<int,int> position, std::pair<int,int> direction){
+    std::pair playerChunk = ChunkMap::chunkCoordinates(position);
+    int stepX = (direction.first > 0) - (direction.first < 0);
+    int stepY = (direction.second > 0) - (direction.second < 0);
+
+    {
+        std::lock_guard lock(mutex);
+        clearRequests();
+        for (int i = playerChunk.first - lookahead*(1 + (stepX < 0)); i <= playerChunk.first + lookahead*(1 + (stepX > 0)); i++){
+            for (int j = playerChunk.second - lookahead*(1 + (stepY < 0)); j <= playerChunk.second + lookahead*(1 + (stepY > 0)); j++){
+                int offsetX = i - playerChunk.first;
+                int offsetY = j - playerChunk.second;
+                // Chunks ahead of the player count as half as far away, chunks behind as twice as far
+                int ahead = offsetX*stepX + offsetY*stepY;
+                int distance = 2*std::max(std::abs(offsetX), std::abs(offsetY));
+                distance -= ahead > 0 ? ahead : 2*ahead;
+                queue(board, std::make_pair(i,j), distance);
+            }
+        }
+        std::make_heap(requests.begin(), requests.end());
+    }
+    requested.notify_one();
+}
+
+void Streamer::request(const Board& board, std::pair<int,int> center, int radius){
+    std::pair firstChunk = ChunkMap::chunkCoordinates(std::make_pair(center.first - radius, center.second - radius));
+    std::pair lastChunk = ChunkMap::chunkCoordinates(std::make_pair(center.first + radius, center.second + radius));
+    {
+        std::lock_guard lock(mutex);
+        int priority = -1;
+        for (auto& request : requests) priority = std::min(priority, request.priority - 1);
+        for (int i = firstChunk.first; i <= lastChunk.first; i++){
+            for (int j = firstChunk.second; j <= lastChunk.second; j++) queue(board, std::make_pair(i,j), priority);
+        }
+        std::make_heap(requests.begin(), requests.end());
+    }
+    requested.notify_one();
+}
+
+void Streamer::clearRequests(){
+    for (auto& request : requests) inFlight.erase(request.chunkCoordinates);
+    requests.clear();
+}
+
+void Streamer::cancel(){
+    std::lock_guard lock(mutex);
+    clearRequests();
+}
+
+int Streamer::collect(Board& board){
+    std::vector<std::pair<std::pair<int,int>, Chunk>> chunks;
+    {
+        std::lock_guard lock(mutex);
+        chunks.swap(completed);
+        for (auto& [chunkCoordinates, chunk] : chunks) inFlight.erase(chunkCoordinates);
+    }
+    for (auto& [chunkCoordinates, chunk] : chunks){
+        board.addGeneratedChunk(chunkCoordinates, chunk);
+        if (onChunkReady) onChunkReady(chunkCoordinates);
+    }
+    return chunks.size();
+}
+
+void Streamer::waitFor(Board& board, std::pair<int,int> center, int radius){
+    request(board, center, radius);
+    while (true){
+        collect(board);
+        if (board.regionReady(center, radius)) return;
+
+        std::unique_lock lock(mutex);
+        if (inFlight.empty()) return;
+        generated.wait(lock, [this]{return !completed.empty();});
+    }
+}
+
+void Streamer::waitForAll(Board& board){
+    while (true){
+        collect(board);
+
+        std::unique_lock lock(mutex);
+        if (inFlight.empty()) return;
+        generated.wait(lock, [this]{return !completed.empty();});
+    }
+}
+
+int Streamer::pending(){
+    std::lock_guard lock(mutex);
+    return requests.size();
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#ifndef STREAMER
+#define STREAMER
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "board.h"
+#include "generator.h"
+
+/**
+ * @brief Generates chunks on a background thread ahead of the player
+ * 
+ * The background thread only ever runs the Generator, it never touches
+ * the Board. Finished chunks wait in the streamer until the thread that
+ * owns the board collects them, so the board needs no locking.
+ */
+class Streamer{
+    /** A chunk waiting to be generated */
+    struct Request{
+        /** Lower values are generated first */
+        int priority;
+        /** Coordinates of the chunk */
+        std::pair<int,int> chunkCoordinates;
+
+        bool operator<(const Request& rhs) const {return priority > rhs.priority;}
+    };
+
+    /** Generator shared with the board */
+    Generator generator;
+    /** Number of chunks to keep generated around (and ahead of) the player */
+    int lookahead;
+    /** Heap of requested chunks */
+    std::vector<Request> requests;
+    /** Chunks being generated or waiting to be collected */
+    std::unordered_set<std::pair<int,int>, CoordinateHash> inFlight;
+    /** Generated chunks waiting to be collected */
+    std::vector<std::pair<std::pair<int,int>, Chunk>> completed;
+    /** Called on the collecting thread for every chunk added to the board */
+    std::function<void(std::pair<int,int>)> onChunkReady;
+    std::mutex mutex;
+    /** Signalled when requests are added or the streamer stops */
+    std::condition_variable requested;
+    /** Signalled when a chunk finishes generating */
+    std::condition_variable generated;
+    bool stopping = false;
+    std::thread worker;
+
+    /**
+     * @brief Generates requested chunks until the streamer stops
+     * 
+     */
+    void work();
+
+    /**
+     * @brief Queue a chunk unless it is generated or already being generated
+     * 
+     * A chunk that is already queued keeps its place unless the new priority
+     * is sooner. Must be called with the mutex held, and the heap rebuilt after.
+     * 
+     * @param board Board the chunk is for
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param priority Priority of the request (lower is sooner)
+     */
+    void queue(const Board& board, std::pair<int,int> chunkCoordinates, int priority);
+
+    /**
+     * @brief Drop every queued request
+     * 
+     * Must be called with the mutex held.
+     * 
+     */
+    void clearRequests();
+
+public:
+    /**
+     * @brief Start the background thread
+     * 
+     * @param board Board to generate for (only its seed is kept)
+     * @param lookahead Number of chunks to keep generated around the player
+     */
+    Streamer(const Board& board, int lookahead = 2);
+
+    /**
+     * @brief Stop and join the background thread
+     * 
+     */
+    ~Streamer();
+
+    Streamer(const Streamer&) = delete;
+    Streamer& operator=(const Streamer&) = delete;
+
+    /**
+     * @brief Set the function called for every chunk added to the board
+     * 
+     * @param callback Function taking the coordinates of the chunk
+     */
+    void setOnChunkReady(std::function<void(std::pair<int,int>)> callback);
+
+    /**
+     * @brief Replace the queued requests with the chunks around the player
+     * 
+     * Chunks within lookahead of the player are queued nearest first, and
+     * the ring is stretched in the direction of movement so the chunks the
+     * player is heading into come before the ones behind. Requests that
+     * are no longer wanted are cancelled.
+     * 
+     * @param board Board being played on
+     * @param position Position of the player
+     * @param direction Direction of movement (0,0 if standing still)
+     */
+    void follow(const Board& board, std::pair<int,int> position, std::pair<int,int> direction = std::make_pair(0,0));
+
+    /**
+     * @brief Request every chunk touching a square region ahead of anything else queued
+     * 
+     * @param board Board being played on
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     */
+    void request(const Board& board, std::pair<int,int> center, int radius);
+
+    /**
+     * @brief Cancel every queued request
+     * 
+     * Chunks already being generated still finish.
+     */
+    void cancel();
+
+    /**
+     * @brief Add every finished chunk to the board
+     * 
+     * @param board Board being played on
+     * @return Number of chunks added
+     */
+    int collect(Board& board);
+
+    /**
+     * @brief Block until every tile in a square region is ready
+     * 
+     * Finished chunks are collected into the board while waiting. Returns
+     * early if nothing left in flight could make the region ready.
+     * 
+     * @param board Board being played on
+     * @param center Center of the region
+     * @param radius Radius of the region in tiles
+     */
+    void waitFor(Board& board, std::pair<int,int> center, int radius);
+
+    /**
+     * @brief Block until every requested chunk is generated and added to the board
+     * 
+     * @param board Board being played on
+     */
+    void waitForAll(Board& board);
+
+    /**
+     * @brief Get the number of queued requests
+     * 
+     * @return Number of queued requests
+     */
+    int pending();
+};
+
+#endif
\ No newline at end of file
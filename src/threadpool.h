@@ -0,0 +1,102 @@
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running queued tasks
+ * 
+ */
+class ThreadPool{
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+
+    void work(){
+        while (true){
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [this]{return stopping || !tasks.empty();});
+                if (stopping && tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+public:
+    /**
+     * @brief Start the worker threads
+     * 
+     * @param threads Number of workers (0 to use one per hardware thread)
+     */
+    ThreadPool(int threads = 0){
+        if (threads <= 0) threads = defaultThreads();
+        workers.reserve(threads);
+        for (int i = 0; i < threads; i++) workers.emplace_back(&ThreadPool::work, this);
+    }
+
+    /**
+     * @brief Finish all queued tasks and join the workers
+     * 
+     */
+    ~ThreadPool(){
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of hardware threads (at least 1)
+     * 
+     * @return Number of hardware threads
+     */
+    static int defaultThreads(){
+        int threads = std::thread::hardware_concurrency();
+        return threads > 0 ? threads : 1;
+    }
+
+    /**
+     * @brief Get the number of workers
+     * 
+     * @return Number of workers
+     */
+    int size() const {return workers.size();}
+
+    /**
+     * @brief Queue a task to run on a worker
+     * 
+     * @tparam Function Callable taking no arguments
+     * @param function Task to run
+     * @return Future holding the task's result
+     */
+    template<class Function>
+    auto submit(Function function) -> std::future<decltype(function())>{
+        auto task = std::make_shared<std::packaged_task<decltype(function())()>>(std::move(function));
+        auto future = task->get_future();
+        {
+            std::lock_guard lock(mutex);
+            tasks.emplace([task]{(*task)();});
+        }
+        condition.notify_one();
+        return future;
+    }
+};
+
+#endif
\ No newline at end of file
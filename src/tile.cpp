@@ -1,26 +1,34 @@
 #include "tile.h"
 
-#include "global.h"
+#include "exceptions.h"
 
-Tile::Tile(){}
+static_assert(TileGen::biomeCount <= 8, "Biomes must fit in 3 bits");
+static_assert(FeatureGen::featureCount <= 16, "Features must fit in 4 bits");
 
-Tile::Tile(int biome) : biome(biome){
-    ready = false;
-    feature = featGen.none;
-    travelCost = tileGen.biomeTravelCosts.at(biome);
+Tile::Tile(int biome){
+    if (biome < 0 || biome >= TileGen::biomeCount) throw InvalidBiomeFound();
+    bits = biome;
 }
 
-int Tile::getBiome() const {return biome;}
+int Tile::getBiome() const {return bits & biomeMask;}
 
-void Tile::setFeature(int newFeature){feature = newFeature;}
+void Tile::setFeature(int newFeature){
+    if (newFeature < 0 || newFeature >= FeatureGen::featureCount) throw InvalidFeatureFound();
+    bits = (bits & ~featureMask) | (newFeature << featureShift);
+}
 
-int Tile::getFeature() const {return feature;}
+int Tile::getFeature() const {return (bits & featureMask) >> featureShift;}
 
-int Tile::getTravelCost() const {return travelCost;}
+int Tile::getTravelCost() const {return TileGen::biomeTravelCosts[getBiome()];}
 
 bool Tile::isTravellable() const {
-    if (tileGen.biomeTravelCosts.at(biome) == 1000) return false;
+    if (getTravelCost() == TileGen::impassable) return false;
     else return true;
 }
 
-bool Tile::isReady() const {return ready;}
\ No newline at end of file
+void Tile::setReady(bool newReady){
+    if (newReady) bits |= readyMask;
+    else bits &= ~readyMask;
+}
+
+bool Tile::isReady() const {return bits & readyMask;}
\ No newline at end of file
@@ -1,9 +1,56 @@
 #ifndef TILE
 #define TILE
 
-#include <map>
+#include <array>
+#include <cstdint>
+#include <utility>
 #include <cereal/archives/json.hpp>
 
+/**
+ * @brief Compile-time table of keys and the chance of picking each
+ * 
+ * Chances don't need to add up to 1. The running totals are computed
+ * when the table is built, so picking a key is a single short scan.
+ * 
+ * @tparam N Number of keys
+ */
+template<std::size_t N>
+struct ChanceTable{
+    /** Keys that can be picked */
+    std::array<int, N> keys{};
+    /** Chance of picking each key */
+    std::array<double, N> chances{};
+    /** Running total of the chances up to and including each key */
+    std::array<double, N> cumulative{};
+
+    /**
+     * @brief Build the table from key, chance pairs
+     * 
+     * @param entries Key, chance pairs
+     */
+    constexpr ChanceTable(const std::array<std::pair<int,double>, N>& entries){
+        double total = 0;
+        for (std::size_t i = 0; i < N; i++){
+            keys[i] = entries[i].first;
+            chances[i] = entries[i].second;
+            total += entries[i].second;
+            cumulative[i] = total;
+        }
+    }
+
+    /**
+     * @brief Pick a key
+     * 
+     * @param random Uniformly distributed value in [0,1)
+     * @return Key picked
+     */
+    constexpr int pick(double random) const {
+        double target = random * cumulative[N-1];
+        for (std::size_t i = 0; i < N; i++) if (cumulative[i] > target) return keys[i];
+        return keys[N-1];
+    }
+};
+
 /**
  * @brief Defines some useful values used in tile generation
  * 
@@ -11,25 +58,29 @@
 struct TileGen{
     /** Names of all biomes currently used */
     enum biomes {plains, forest, ocean, desert, mountains};
+    /** Number of biomes */
+    static constexpr int biomeCount = mountains + 1;
     /** Defines minimum biome size */
-    const int minBiomeSize = 2;
+    static constexpr int minBiomeSize = 2;
     /** Defines max biome size */
-    const int maxBiomeSize = 5;
+    static constexpr int maxBiomeSize = 5;
+    /** Travel cost of biomes that can't be traversed */
+    static constexpr int impassable = 1000;
     /** Defines chances for each biome to generate */
-    const std::map<int,double> biomeChances = {
+    static constexpr ChanceTable<biomeCount> biomeChances{{{
         {plains,0.25},
         {forest,0.35},
         {ocean,0.2},
         {desert,0.1},
         {mountains,0.1}
-    };
-    /** Defines travel costs for each biome */
-    const std::map<int,int> biomeTravelCosts = {
-        {plains,2},
-        {forest,5},
-        {ocean,1000},
-        {desert,3},
-        {mountains,1000}
+    }}};
+    /** Defines travel costs for each biome, indexed by biome */
+    static constexpr std::array<int, biomeCount> biomeTravelCosts = {
+        2,          // plains
+        5,          // forest
+        impassable, // ocean
+        3,          // desert
+        impassable  // mountains
     };
 };
 
@@ -41,17 +92,19 @@ struct FeatureGen{
     /** Names of all features currently used */
     enum features {none, any, city, cityMarket, cityHarbour, cityPlaza, cityArena, cityPrison, cityNeighbourhood,
         village, camp, loneHouse, cave, lake};
+    /** Number of features */
+    static constexpr int featureCount = lake + 1;
     /** Defines chance for any feature to generate */
-    const double featureChance = 0.05;
+    static constexpr double featureChance = 0.05;
     /** Defines chances for each feature to generate */
-    const std::map<int, double> featureChances = {
+    static constexpr ChanceTable<6> featureChances{{{
         {city, 0.10},
         {village, 0.20},
         {camp, 0.25},
         {loneHouse, 0.1},
         {cave, 0.15},
         {lake, 0.20}
-    };
+    }}};
 
     /**
      * @brief Defines chances for ADDITIONAL district to generate
@@ -66,61 +119,98 @@ struct FeatureGen{
      * districts are unique (harbour, arena, prison). They are removed
      * from the odds if they already exist. 
      */
-    const std::map<int, double> cityDistrictChances = {
+    static constexpr ChanceTable<5> cityDistrictChances{{{
         {cityMarket, 0.1},
         {cityPlaza, 0.3},
         {cityArena, 0.1},
         {cityPrison, 0.3},
         {cityNeighbourhood, 0.2}
-    };
+    }}};
     /** Defines minimum number of districts a city will generate */
-    const int minCityDistricts = 2;
+    static constexpr int minCityDistricts = 2;
     /** Defines maximum number of districts a city will generate */
-    const int maxCityDistricts = 9;
+    static constexpr int maxCityDistricts = 9;
 };
 
 /**
  * @brief Contains all information relating to a tile
  * 
+ * Packed into a single byte: the biome takes the low 3 bits, the feature
+ * the next 4 and the ready status the top bit. Travel cost is derived
+ * from the biome rather than stored. The layout is public so that tiles
+ * can be scanned in bulk as bytes.
  */
 class Tile{
-    /** The tile ready status. True when the tile is fully generated */
-    bool ready;
-    /** The biome at the tile */
-    int biome;
-    /** The feature at the tile */
-    int feature;
-    /** The cost of traversing the tile */
-    int travelCost;
+    /** Biome, feature and ready status of the tile */
+    std::uint8_t bits = 0;
 public:
+    /** Bits holding the biome */
+    static constexpr std::uint8_t biomeMask = 0x07;
+    /** Bits holding the feature */
+    static constexpr std::uint8_t featureMask = 0x78;
+    /** Position of the feature bits */
+    static constexpr int featureShift = 3;
+    /** Bit holding the ready status (true when the tile is fully generated) */
+    static constexpr std::uint8_t readyMask = 0x80;
+
     /**
      * @brief Construct a new Tile object (default constructor)
      * 
      * The default constructor is required to deserialize the Tile object
      */
-    Tile();
+    Tile() = default;
 
     /**
      * @brief Create a new tile and set it to a biome
      * 
      * @param biome The biome to initialize the tile with
+     * @throws InvalidBiomeFound if the biome doesn't exist
      */
     Tile(int biome);
 
     /**
      * @brief Allows serialization of Tile class
      * 
+     * Writes the same fields the unpacked tile did, so saves stay compatible.
+     * 
+     * @tparam Archive 
+     * @param archive 
+     */
+    template<class Archive>
+    void save(Archive& archive) const {
+        bool ready = isReady();
+        int biome = getBiome();
+        int feature = getFeature();
+        int travelCost = getTravelCost();
+        archive(
+            cereal::make_nvp("Ready",ready),
+            cereal::make_nvp("Biome",biome),
+            cereal::make_nvp("Feature",feature),
+            cereal::make_nvp("Travel Cost",travelCost)
+        );
+    }
+
+    /**
+     * @brief Allows deserialization of Tile class
+     * 
      * @tparam Archive 
      * @param archive 
      */
     template<class Archive>
-    void serialize(Archive& archive){
+    void load(Archive& archive){
+        bool ready;
+        int biome;
+        int feature;
+        int travelCost;
         archive(
             cereal::make_nvp("Ready",ready),
             cereal::make_nvp("Biome",biome),
             cereal::make_nvp("Feature",feature),
             cereal::make_nvp("Travel Cost",travelCost)
         );
+        *this = Tile(biome);
+        setFeature(feature);
+        setReady(ready);
     }
 
     /**
@@ -134,6 +224,7 @@ public:
      * @brief Set the feature of the tile
      * 
      * @param newFeature Feature to set
+     * @throws InvalidFeatureFound if the feature doesn't exist
      */
     void setFeature(int newFeature);
 
@@ -158,6 +249,13 @@ public:
      */
     bool isTravellable() const;
 
+    /**
+     * @brief Set the ready status of the tile
+     * 
+     * @param newReady Ready status to set
+     */
+    void setReady(bool newReady);
+
     /**
      * @brief Return the ready status of the tile
      * 
@@ -166,4 +264,6 @@ public:
     bool isReady() const;
 };
 
+static_assert(sizeof(Tile) == 1, "Tile must stay packed into one byte");
+
 #endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "tilescan.h"
+
+#include <algorithm>
+#include <bitset>
+#include "global.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TILE_SCAN_X86
+#endif
+
+namespace {
+    const std::uint8_t* tileBytes(const Chunk& chunk){
+        return reinterpret_cast<const std::uint8_t*>(chunk.tiles.data());
+    }
+
+    ChunkMask scanScalar(const std::uint8_t* bytes, TilePattern pattern){
+        ChunkMask passed{};
+        for (int i = 0; i < Chunk::area; i++){
+            bool passes = ((bytes[i] & pattern.mask) == pattern.value) != pattern.invert;
+            passed[i/64] |= std::uint64_t(passes) << (i%64);
+        }
+        return passed;
+    }
+
+#ifdef TILE_SCAN_X86
+    // A chunk row is 16 tiles, so SSE2 tests one row per compare and AVX2 two
+    __attribute__((target("sse2")))
+    ChunkMask scanSse2(const std::uint8_t* bytes, TilePattern pattern){
+        __m128i mask = _mm_set1_epi8(char(pattern.mask));
+        __m128i value = _mm_set1_epi8(char(pattern.value));
+        std::uint64_t flip = pattern.invert ? ~std::uint64_t(0) : 0;
+        ChunkMask passed{};
+        for (std::size_t word = 0; word < passed.size(); word++){
+            std::uint64_t bits = 0;
+            for (int part = 0; part < 4; part++){
+                __m128i tiles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + word*64 + part*16));
+                __m128i equal = _mm_cmpeq_epi8(_mm_and_si128(tiles, mask), value);
+                bits |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(equal))) << (part*16);
+            }
+            passed[word] = bits ^ flip;
+        }
+        return passed;
+    }
+
+    __attribute__((target("avx2")))
+    ChunkMask scanAvx2(const std::uint8_t* bytes, TilePattern pattern){
+        __m256i mask = _mm256_set1_epi8(char(pattern.mask));
+        __m256i value = _mm256_set1_epi8(char(pattern.value));
+        std::uint64_t flip = pattern.invert ? ~std::uint64_t(0) : 0;
+        ChunkMask passed{};
+        for (std::size_t word = 0; word < passed.size(); word++){
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + word*64));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + word*64 + 32));
+            std::uint32_t lowBits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(low, mask), value));
+            std::uint32_t highBits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(high, mask), value));
+            passed[word] = ((std::uint64_t(highBits) << 32) | lowBits) ^ flip;
+        }
+        return passed;
+    }
+#endif
+}
+
+TilePattern TilePattern::matching(int biome, int feature){
+    if (feature == featGen.any) return TilePattern{Tile::featureMask, featGen.none << Tile::featureShift, true};
+    if (feature != -1) return TilePattern{Tile::featureMask, std::uint8_t(feature << Tile::featureShift), false};
+    if (biome != -1) return TilePattern{Tile::biomeMask, std::uint8_t(biome), false};
+    // Masked bits are always 0, so nothing matches
+    return TilePattern{0, 1, false};
+}
+
+TilePattern TilePattern::ready(){
+    return TilePattern{Tile::readyMask, Tile::readyMask, false};
+}
+
+bool scanKernelSupported(ScanKernel kernel){
+    switch (kernel){
+#ifdef TILE_SCAN_X86
+        case ScanKernel::sse2: return __builtin_cpu_supports("sse2");
+        case ScanKernel::avx2: return __builtin_cpu_supports("avx2");
+#endif
+        case ScanKernel::scalar: return true;
+        default: return false;
+    }
+}
+
+ScanKernel bestScanKernel(){
+    static const ScanKernel best = scanKernelSupported(ScanKernel::avx2) ? ScanKernel::avx2
+        : scanKernelSupported(ScanKernel::sse2) ? ScanKernel::sse2 : ScanKernel::scalar;
+    return best;
+}
+
+ChunkMask scanChunk(const Chunk& chunk, TilePattern pattern){
+    return scanChunk(chunk, pattern, bestScanKernel());
+}
+
+ChunkMask scanChunk(const Chunk& chunk, TilePattern pattern, ScanKernel kernel){
+    if (!scanKernelSupported(kernel)) kernel = ScanKernel::scalar;
+    ChunkMask passed;
+    switch (kernel){
+#ifdef TILE_SCAN_X86
+        case ScanKernel::sse2: passed = scanSse2(tileBytes(chunk), pattern); break;
+        case ScanKernel::avx2: passed = scanAvx2(tileBytes(chunk), pattern); break;
+#endif
+        default: passed = scanScalar(tileBytes(chunk), pattern);
+    }
+    for (std::size_t word = 0; word < passed.size(); word++) passed[word] &= chunk.present[word];
+    return passed;
+}
+
+ChunkMask rectangleMask(std::pair<int,int> chunkCoordinates, std::pair<int,int> first, std::pair<int,int> last){
+    ChunkMask inside{};
+    auto origin = ChunkMap::tileCoordinates(chunkCoordinates, 0);
+    int firstRow = std::max(first.first - origin.first, 0);
+    int lastRow = std::min(last.first - origin.first, Chunk::size - 1);
+    int firstColumn = std::max(first.second - origin.second, 0);
+    int lastColumn = std::min(last.second - origin.second, Chunk::size - 1);
+    if (firstColumn > lastColumn) return inside;
+
+    // Each row of a chunk is 16 consecutive bits of the mask
+    std::uint64_t row = ((std::uint64_t(1) << (lastColumn - firstColumn + 1)) - 1) << firstColumn;
+    for (int i = firstRow; i <= lastRow; i++){
+        int index = i*Chunk::size;
+        inside[index/64] |= row << (index%64);
+    }
+    return inside;
+}
+
+int countMask(const ChunkMask& mask){
+    int total = 0;
+    for (auto& word : mask) total += std::bitset<64>(word).count();
+    return total;
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef TILE_SCAN
+#define TILE_SCAN
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "chunk.h"
+
+/** One bit per tile of a chunk, by local index, laid out like Chunk::present */
+using ChunkMask = std::array<std::uint64_t, Chunk::area/64>;
+
+/**
+ * @brief Test that packed tiles are scanned against
+ *
+ * A tile passes when its bits, masked, equal the value (or differ from it,
+ * if inverted), so one test covers a biome, a feature, any feature or the
+ * ready status.
+ */
+struct TilePattern{
+    /** Bits of the tile that are compared */
+    std::uint8_t mask = 0;
+    /** Value the masked bits are compared to */
+    std::uint8_t value = 0;
+    /** Whether tiles pass when the masked bits differ from the value instead */
+    bool invert = false;
+
+    /**
+     * @brief Make the pattern for tiles matching a biome and/or feature, the way Board::tileMatches does
+     *
+     * @param biome Biome to look for (-1 to ignore)
+     * @param feature Feature to look for (-1 to ignore, featGen.any for any feature), takes precedence over the biome
+     * @return Pattern (matching nothing if both are -1)
+     */
+    static TilePattern matching(int biome, int feature);
+
+    /**
+     * @brief Make the pattern for ready tiles
+     *
+     * @return Pattern
+     */
+    static TilePattern ready();
+};
+
+/**
+ * @brief Instruction sets a chunk can be scanned with
+ *
+ */
+enum class ScanKernel {scalar, sse2, avx2};
+
+/**
+ * @brief Get the fastest kernel the processor supports (checked once, at runtime)
+ *
+ * @return Kernel
+ */
+ScanKernel bestScanKernel();
+
+/**
+ * @brief Check if the processor supports a kernel
+ *
+ * @param kernel Kernel to check
+ * @return Whether or not the kernel can be used
+ */
+bool scanKernelSupported(ScanKernel kernel);
+
+/**
+ * @brief Find the present tiles of a chunk that pass a pattern, with the fastest kernel
+ *
+ * @param chunk Chunk to scan
+ * @param pattern Pattern to test tiles against
+ * @return Mask of the present tiles that pass
+ */
+ChunkMask scanChunk(const Chunk& chunk, TilePattern pattern);
+
+/**
+ * @brief Find the present tiles of a chunk that pass a pattern, with a chosen kernel
+ *
+ * @param chunk Chunk to scan
+ * @param pattern Pattern to test tiles against
+ * @param kernel Kernel to scan with (scalar is used instead if it isn't supported)
+ * @return Mask of the present tiles that pass
+ */
+ChunkMask scanChunk(const Chunk& chunk, TilePattern pattern, ScanKernel kernel);
+
+/**
+ * @brief Get the tiles of a chunk that lie in a rectangle
+ *
+ * @param chunkCoordinates Chunk coordinates
+ * @param first Corner of the rectangle with the lowest coordinates
+ * @param last Corner of the rectangle with the highest coordinates
+ * @return Mask of the tiles inside the rectangle
+ */
+ChunkMask rectangleMask(std::pair<int,int> chunkCoordinates, std::pair<int,int> first, std::pair<int,int> last);
+
+/**
+ * @brief Count the tiles set in a mask
+ *
+ * @param mask Mask to count
+ * @return Number of tiles
+ */
+int countMask(const ChunkMask& mask);
+
+/**
+ * @brief Call a function for every tile set in a mask, in order of local index
+ *
+ * @tparam Function Callable taking a local index
+ * @param mask Mask of tiles
+ * @param function Function to call
+ */
+template<class Function>
+void forEachInMask(const ChunkMask& mask, Function function){
+    for (std::size_t word = 0; word < mask.size(); word++){
+        for (std::uint64_t bits = mask[word]; bits != 0; bits &= bits - 1) function(int(word*64) + __builtin_ctzll(bits));
+    }
+}
+
+#endif
\ No newline at end of file
@@ -1,96 +1,54 @@
 #include "utility.h"
 
-#include <ctime>
 #include <fstream>
 #include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
-#include <cereal/types/map.hpp>
 #include <cereal/types/utility.hpp>
 #include "exceptions.h"
+#include "worldfile.h"
 
-int randInt(int min, int max){
-    return rand() % max + min;
+CoordinateRange getCoordinatesInRadius(std::pair<int,int> coordinates, int radius) {
+    return CoordinateRange(coordinates, radius, false);
 }
 
-bool pickValue(double probability){
-    double random = ((double)rand()/RAND_MAX);
-    return probability >= random;
+CoordinateRange getCoordinatesInRing(std::pair<int,int> coordinates, int radius) {
+    return CoordinateRange(coordinates, radius, true);
 }
 
-int pickByProbability(std::map<int, double> map){
-    double totalVal = 0;
-    for (auto const& [key, val] : map) {
-        totalVal += val;
-    }
-
-    double random = ((double)rand()/RAND_MAX) * totalVal;
-    
-    double incrementalProbability = 0;
-    for (auto const& [key, val] : map){
-        incrementalProbability += val;
-        if (incrementalProbability >= random) return key;
-    }
-    return -1;
+std::array<std::pair<int,int>, 4> getAdjacentCoordinates(std::pair<int,int> coordinates) {
+    return {
+        std::make_pair(coordinates.first-1,coordinates.second),
+        std::make_pair(coordinates.first,coordinates.second-1),
+        std::make_pair(coordinates.first,coordinates.second+1),
+        std::make_pair(coordinates.first+1,coordinates.second)
+    };
 }
 
-std::vector<std::pair<int,int>> getCoordinatesInRadius(std::pair<int,int> coordinates, int radius) {
-    std::vector<std::pair<int,int>> coordinatesInRadius;
-    coordinatesInRadius.reserve(radius*radius);
-    for (int i = coordinates.first - radius; i <= coordinates.first + radius; i++){
-        for (int j = coordinates.second - radius; j <= coordinates.second + radius; j++){
-            coordinatesInRadius.push_back(std::make_pair(i,j));
-        }
-    }
-    return coordinatesInRadius;
-}
-
-std::vector<std::pair<int,int>> getCoordinatesInRing(std::pair<int,int> coordinates, int radius) {
-    std::vector<std::pair<int,int>> coordinatesInRing;
-    coordinatesInRing.reserve(8*radius);
-    for (int i = coordinates.first - radius; i <= coordinates.first + radius; i++){
-        if (i == coordinates.first - radius || i == coordinates.first + radius){
-            for (int j = coordinates.second - radius; j <= coordinates.second + radius; j++){
-                coordinatesInRing.push_back(std::make_pair(i,j));
-            }
-        }
-        else {
-            coordinatesInRing.push_back(std::make_pair(i, coordinates.second - radius));
-            coordinatesInRing.push_back(std::make_pair(i, coordinates.second + radius));
-        }
+void save(const Board& board, std::string savename, bool json){
+    savename.append(".save");
+    if (!json){
+        WorldFile::write(board, savename, WorldFile::Layout::delta);
+        return;
     }
-    return coordinatesInRing;
-}
-
-std::vector<std::pair<int,int>> getAdjacentCoordinates(std::pair<int,int> coordinates) {
-    std::vector<std::pair<int,int>> adjacentCoordinates;
-    adjacentCoordinates.reserve(4);
-    adjacentCoordinates.push_back(std::make_pair(coordinates.first-1,coordinates.second));
-    adjacentCoordinates.push_back(std::make_pair(coordinates.first,coordinates.second-1));
-    adjacentCoordinates.push_back(std::make_pair(coordinates.first,coordinates.second+1));
-    adjacentCoordinates.push_back(std::make_pair(coordinates.first+1,coordinates.second));
-    return adjacentCoordinates;
-}
+    savename.append(".json");
 
-void save(Board board, std::string savename, bool json){
-    savename.append(".save");
-    if (json) savename.append(".json");
-    
     std::ofstream ofile(savename);
-    if (json){
-        cereal::JSONOutputArchive oarchive(ofile);
-        oarchive(board);
-    }
-    else {
-        cereal::BinaryOutputArchive oarchive(ofile);
-        oarchive(board);
-    }
+    cereal::JSONOutputArchive oarchive(ofile);
+    oarchive(board);
 }
 
 Board load(std::string savename, std::pair<int,int> position, bool json){
-    Board board;
     savename.append(".save");
     if (json) savename.append(".json");
 
+    if (!json && WorldFile::isWorldFile(savename)){
+        Board board(std::make_shared<WorldFile>(savename), position);
+        if (!board.verify(position)) throw InvalidBoardLoad();
+        return board;
+    }
+
+    // JSON exports and saves from before world files are read whole, into a board with nothing generated to throw away
+    Board board(Board::Empty{});
     std::ifstream ifile(savename);
     if (json){
         cereal::JSONInputArchive iarchive(ifile);
@@ -1,85 +1,153 @@
 #ifndef UTILITY
 #define UTILITY
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <vector>
 #include "board.h"
 
 /**
- * @brief Implements hashing for pairs
+ * @brief Implements hashing for pairs (use CoordinateHash for coordinates)
  * 
+ * Each half is mixed before they are combined, so swapped or equal halves
+ * don't collide the way a plain xor of their hashes would.
  */
 struct PairHash{
     template <class T1, class T2>
     std::size_t operator() (const std::pair<T1, T2> &pair) const {
-        return std::hash<T1>()(pair.first) ^ std::hash<T2>()(pair.second);
+        return CoordinateHash::mix(CoordinateHash::mix(std::hash<T1>()(pair.first)) ^ std::hash<T2>()(pair.second));
     }
 };
 
 /**
- * @brief Generates a random integer between min and max
+ * @brief Coordinates in a square or ring around some coordinates, made as they are iterated
  * 
- * @param min Smallest possible return value
- * @param max Largest possible return value
- * @return Randomly chosen int
+ * Nothing is stored but the bounds, so iterating never allocates. The
+ * coordinates come row by row, in the same order the vectors these replaced
+ * held them. Copy them into a container to shuffle or keep them.
  */
-int randInt(int min, int max);
+class CoordinateRange{
+    std::pair<int,int> center;
+    int radius;
+    /** Whether only the edge of the square is included */
+    bool ring;
+public:
+    /** Iterator holding the coordinates it is at, and the bounds to step within */
+    class iterator{
+        /** Bounds of the square */
+        int top, bottom, low, high;
+        bool ring;
+        std::pair<int,int> here;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<int,int>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::pair<int,int>*;
+        using reference = const std::pair<int,int>&;
 
-/**
- * @brief Picks a value (or doesn't) based on probability
- * 
- * @param probability The probability to pick a value
- * @return Whether or not the value was picked
- */
-bool pickValue(double probability);
+        iterator(const CoordinateRange& range, std::pair<int,int> here)
+            : top(range.center.first - range.radius), bottom(range.center.first + range.radius),
+            low(range.center.second - range.radius), high(range.center.second + range.radius), ring(range.ring), here(here){}
 
-/**
- * @brief Pick a key from the map based on a probability value
- * 
- * @param map Map to pick from
- * @return Key returned 
- */
-int pickByProbability(std::map<int, double> map);
+        reference operator*() const {return here;}
+        pointer operator->() const {return &here;}
+
+        iterator& operator++(){
+            bool edgeRow = here.first == top || here.first == bottom;
+            if (here.second < high && (edgeRow || !ring)) here.second++;
+            // Rows between the edges of a ring only have their two ends
+            else if (here.second == low && ring && !edgeRow) here.second = high;
+            else here = std::make_pair(here.first + 1, low);
+            return *this;
+        }
+
+        iterator operator++(int){
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const iterator& rhs) const {return here == rhs.here;}
+        bool operator!=(const iterator& rhs) const {return here != rhs.here;}
+    };
+
+    /**
+     * @brief Create a range of coordinates
+     * 
+     * @param center x,y pair of coordinates at the centre
+     * @param radius Radius of the square (empty if negative)
+     * @param ring Whether to only include the edge of the square
+     */
+    CoordinateRange(std::pair<int,int> center, int radius, bool ring) : center(center), radius(radius), ring(ring){}
+
+    iterator begin() const {
+        if (radius < 0) return end();
+        return iterator(*this, std::make_pair(center.first - radius, center.second - radius));
+    }
+
+    iterator end() const {return iterator(*this, std::make_pair(center.first + std::max(radius, -1) + 1, center.second - radius));}
+
+    /**
+     * @brief Get the number of coordinates in the range
+     * 
+     * @return Number of coordinates
+     */
+    std::size_t size() const {
+        if (radius < 0) return 0;
+        if (ring) return radius == 0 ? 1 : 8*radius;
+        return std::size_t(2*radius + 1)*(2*radius + 1);
+    }
+};
 
 /**
- * @brief Generates a vector of coordinates in a radius around some coordinates
+ * @brief Get the coordinates in a radius around some coordinates
  * 
  * @param coordinates x,y pair of coordinates
  * @param radius Radius to look around
- * @return A vector containing the requested coordinates 
+ * @return Range of the requested coordinates
  */
-std::vector<std::pair<int,int>> getCoordinatesInRadius(std::pair<int,int> coordinates, int radius);
+CoordinateRange getCoordinatesInRadius(std::pair<int,int> coordinates, int radius);
 /**
- * @brief Generates a vector of coordinates in a ring at a radius around some coordinates
+ * @brief Get the coordinates in a ring at a radius around some coordinates
  * 
  * @param coordinates x,y pair of coordinates
  * @param radius Radius of ring to look at
- * @return A vector containing the requested coordinates
+ * @return Range of the requested coordinates
  */
-std::vector<std::pair<int,int>> getCoordinatesInRing(std::pair<int,int> coordinates, int radius);
+CoordinateRange getCoordinatesInRing(std::pair<int,int> coordinates, int radius);
 /**
- * @brief Generates a vector of coordinates adjacent some coordinates
+ * @brief Get the coordinates adjacent some coordinates
  * 
  * Here, diagonal connections are not considered adjacent since 
  * diagonal moves are not allowed
  * 
- * @param coordinates A vector containing the requested coordinates
- * @return A vector containing the requested coordinates
+ * @param coordinates x,y pair of coordinates
+ * @return The adjacent coordinates, up, left, right then down
  */
-std::vector<std::pair<int,int>> getAdjacentCoordinates(std::pair<int,int> coordinates);
+std::array<std::pair<int,int>, 4> getAdjacentCoordinates(std::pair<int,int> coordinates);
 
 /**
  * @brief Saves the board to a file
  * 
+ * Writes a world file holding the seed and only the tiles that differ from
+ * what it generates, or a readable cereal JSON export for debugging if json
+ * is set. JSON exports are far larger and slower to write and read.
+ * 
  * @param board Board to save
  * @param savename Name to save under
- * @Whether or not to use json
+ * @param json Whether or not to write a JSON export instead
  */
-void save(Board board, std::string savename, bool json = false);
+void save(const Board& board, std::string savename, bool json = false);
 
 /**
  * @brief Loads board from a file
  * 
+ * World files are opened lazily: only the chunks in view of the position are
+ * read, and the rest as they are generated. JSON exports and older binary
+ * saves are read whole.
+ * 
  * @param savename Name of save to load
  * @param position Position of the player
  * @param json Whether or not to use json
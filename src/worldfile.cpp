@@ -0,0 +1,628 @@
+#include "worldfile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "exceptions.h"
+#include "generator.h"
+
+static_assert(std::is_trivially_copyable_v<Chunk>, "Mapped world files use chunks in place");
+
+namespace {
+    /** Size of the header in bytes */
+    constexpr std::size_t headerSize = 40;
+    /** Size of an index entry in bytes (mapped layout) */
+    constexpr std::size_t mappedEntrySize = 8;
+    /** Written in the machine's byte order, so mapped files can be checked against it */
+    constexpr std::uint32_t byteOrder = 0x01020304;
+    /** Marks the start of a journal */
+    constexpr char journalMagic[4] = {'M','T','G','J'};
+    /** Size of the journal header (magic, version and stamp) in bytes */
+    constexpr std::size_t journalHeaderSize = 16;
+    /** Size of a journal record header (coordinates, blob size and checksum) in bytes */
+    constexpr std::size_t recordHeaderSize = 16;
+
+    void putInt(std::string& out, std::uint64_t value, int bytes){
+        for (int i = 0; i < bytes; i++) out.push_back(char((value >> (8*i)) & 0xff));
+    }
+
+    std::uint64_t getInt(const char* in, int bytes){
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) value |= std::uint64_t(std::uint8_t(in[i])) << (8*i);
+        return value;
+    }
+
+    /** Seven bits a byte, low bits first, so small values take a single byte */
+    void putVarint(char*& out, std::uint64_t value){
+        while (value >= 0x80){
+            *out++ = char(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = char(value);
+    }
+
+    void putVarint(std::string& out, std::uint64_t value){
+        char buffer[10];
+        char* end = buffer;
+        putVarint(end, value);
+        out.append(buffer, end);
+    }
+
+    std::uint64_t getVarint(const char*& in, const char* end){
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7){
+            if (in == end) throw InvalidWorldFile();
+            std::uint8_t byte = *in++;
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        throw InvalidWorldFile();
+    }
+
+    /** Interleaves negative and positive values, so small values of either sign stay small varints */
+    std::uint64_t zigzag(std::int64_t value){
+        return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value){
+        return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+    }
+
+    /** Set in a blob's flags when every tile of the chunk is present, and the presence mask is left out */
+    constexpr std::uint8_t fullChunk = 0x01;
+
+    /** Largest possible blob: flags, presence mask, palette of every tile value, and a run for every tile */
+    constexpr std::size_t maxBlobSize = 1 + Chunk::area/8 + 2 + 256 + 3*Chunk::area;
+
+    /** Bits needed to pick an entry of a palette */
+    int paletteBits(std::size_t paletteSize){
+        int bits = 0;
+        while ((std::size_t(1) << bits) < paletteSize) bits++;
+        return bits;
+    }
+
+    /** Tiles are stored as biome, feature and ready bits, independent of how Tile packs them */
+    std::uint8_t tileByte(const Tile& tile){
+        return tile.getBiome() | (tile.getFeature() << 3) | (tile.isReady() << 7);
+    }
+
+    Tile byteTile(std::uint8_t value){
+        Tile tile(value & 0x07);
+        tile.setFeature((value >> 3) & 0x0f);
+        tile.setReady(value >> 7);
+        return tile;
+    }
+
+    /** A chunk exactly as it is in memory */
+    std::string chunkImage(const Chunk& chunk){
+        return std::string(reinterpret_cast<const char*>(&chunk), sizeof(Chunk));
+    }
+
+    std::int32_t nativeInt(const char* in){
+        std::int32_t value;
+        std::memcpy(&value, in, sizeof(value));
+        return value;
+    }
+
+    /** The tiles of a chunk that the generator wouldn't make, as a chunk holding only those */
+    Chunk difference(const Chunk& chunk, const Chunk& generated){
+        Chunk delta;
+        for (int i = 0; i < Chunk::area; i++){
+            if (chunk.contains(i) && std::memcmp(&chunk.tiles[i], &generated.tiles[i], sizeof(Tile)) != 0) delta.set(i, chunk.tiles[i]);
+        }
+        return delta;
+    }
+
+    /** A generated chunk with the tiles of a delta laid over it */
+    Chunk applyDifference(Chunk generated, const Chunk& delta){
+        for (int i = 0; i < Chunk::area; i++) if (delta.contains(i)) generated.tiles[i] = delta.tiles[i];
+        return generated;
+    }
+
+    /**
+     * A chunk in the form stored by a layout. In the delta layout, only the tiles that differ
+     * from the generator are stored, and chunks that don't differ store nothing (an empty blob)
+     */
+    std::string storeChunk(const Chunk& chunk, std::pair<int,int> chunkCoordinates, WorldFile::Layout layout, int seed){
+        if (layout == WorldFile::Layout::mapped) return chunkImage(chunk);
+        if (layout == WorldFile::Layout::packed) return WorldFile::encode(chunk);
+        Chunk delta = difference(chunk, Generator(seed).generateChunk(chunkCoordinates));
+        return delta.count() == 0 ? std::string() : WorldFile::encode(delta);
+    }
+
+    std::string journalName(const std::string& filename){
+        return filename + ".journal";
+    }
+
+    /** FNV-1a, enough to tell a torn or garbled record from a complete one */
+    std::uint32_t checksum(const char* data, std::size_t size){
+        std::uint32_t hash = 2166136261u;
+        for (std::size_t i = 0; i < size; i++){
+            hash ^= std::uint8_t(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    /** Flush a written file to disk, so renaming it over another can't leave it half written after a crash */
+    void syncFile(const std::string& filename){
+        int descriptor = open(filename.c_str(), O_RDONLY);
+        if (descriptor == -1) throw WorldFileWriteFailed();
+        bool synced = fsync(descriptor) == 0;
+        close(descriptor);
+        if (!synced) throw WorldFileWriteFailed();
+    }
+
+    /** Writes from different runs (or the same clock tick) should never share a stamp */
+    std::uint64_t newStamp(){
+        std::uint64_t time = std::chrono::system_clock::now().time_since_epoch().count();
+        return time ^ (std::uint64_t(std::random_device()()) << 32);
+    }
+}
+
+WorldFile::WorldFile(const std::string& filename) : filename(filename), file(filename, std::ios::binary){
+    std::string header(headerSize, '\0');
+    if (!file.read(header.data(), headerSize) || std::memcmp(header.data(), magic, 4) != 0) throw InvalidWorldFile();
+    if (getInt(header.data() + 4, 4) != version) throw InvalidWorldFile();
+    seed = std::int32_t(getInt(header.data() + 8, 4));
+    std::size_t count = getInt(header.data() + 12, 4);
+    stamp = getInt(header.data() + 24, 8);
+    std::uint64_t indexSize = getInt(header.data() + 32, 8);
+
+    std::uint32_t storedLayout = getInt(header.data() + 16, 4);
+    if (storedLayout > std::uint32_t(Layout::delta)) throw InvalidWorldFile();
+    if (storedLayout == std::uint32_t(Layout::delta)) layout = Layout::delta;
+    if (storedLayout == std::uint32_t(Layout::mapped)){
+        std::uint32_t order;
+        std::memcpy(&order, header.data() + 20, sizeof(order));
+        if (order != byteOrder) throw InvalidWorldFile();
+        layout = Layout::mapped;
+        mappedCount = count;
+        file.close();
+        map();
+    }
+
+    if (layout != Layout::mapped){
+        std::error_code error;
+        if (indexSize > std::filesystem::file_size(filename, error) || error) throw InvalidWorldFile();
+        std::string entries(indexSize, '\0');
+        if (!file.read(entries.data(), entries.size())) throw InvalidWorldFile();
+        index.reserve(count);
+        // Coordinates are deltas from the previous entry, and blobs follow the index in index order
+        const char* in = entries.data();
+        const char* end = in + entries.size();
+        std::int64_t x = 0;
+        std::int64_t y = 0;
+        std::uint64_t offset = headerSize + indexSize;
+        for (std::size_t i = 0; i < count; i++){
+            x += unzigzag(getVarint(in, end));
+            y += unzigzag(getVarint(in, end));
+            std::uint64_t size = getVarint(in, end);
+            index[std::make_pair(int(x), int(y))] = Entry{offset, std::uint32_t(size)};
+            offset += size;
+        }
+        if (in != end) throw InvalidWorldFile();
+    }
+    replayJournal();
+}
+
+void WorldFile::replayJournal(){
+    std::ifstream ifile(journalName(filename), std::ios::binary);
+    if (!ifile) return;
+    std::string journal((std::istreambuf_iterator<char>(ifile)), std::istreambuf_iterator<char>());
+    if (journal.size() < journalHeaderSize || std::memcmp(journal.data(), journalMagic, 4) != 0) return;
+    if (getInt(journal.data() + 4, 4) != version || getInt(journal.data() + 8, 8) != stamp) return;
+
+    std::size_t position = journalHeaderSize;
+    while (position + recordHeaderSize <= journal.size()){
+        const char* record = journal.data() + position;
+        std::size_t size = getInt(record + 8, 4);
+        if (position + recordHeaderSize + size > journal.size()) break;
+        std::uint32_t expected = getInt(record + 12, 4);
+        std::string blob(record + recordHeaderSize, size);
+        if (checksum(record, 12) + checksum(blob.data(), size) != expected) break;
+
+        auto chunkCoordinates = std::make_pair(int(std::int32_t(getInt(record, 4))), int(std::int32_t(getInt(record + 4, 4))));
+        journaled[chunkCoordinates] = decodeBlob(chunkCoordinates, blob);
+        position += recordHeaderSize + size;
+    }
+    journalSize = position;
+    for (auto& [chunkCoordinates, chunk] : journaled) if (!inFile(chunkCoordinates)) journaledOnly++;
+}
+
+void WorldFile::append(const std::vector<std::pair<std::pair<int,int>, Chunk>>& chunks){
+    std::string records;
+    if (journalSize == 0){
+        records.append(journalMagic, 4);
+        putInt(records, version, 4);
+        putInt(records, stamp, 8);
+    }
+    std::vector<const std::pair<std::pair<int,int>, Chunk>*> recorded;
+    for (auto& entry : chunks){
+        auto& [chunkCoordinates, chunk] = entry;
+        // Mapped files journal whole chunks, the chunk images are only for the file itself
+        std::string blob = storeChunk(chunk, chunkCoordinates, layout == Layout::mapped ? Layout::packed : layout, seed);
+        if (blob.empty()){
+            // Back to what the generator makes: only needs a record if an older version is stored
+            if (!contains(chunkCoordinates)) continue;
+            blob = encode(Chunk());
+        }
+        recorded.push_back(&entry);
+        std::size_t start = records.size();
+        putInt(records, std::uint32_t(chunkCoordinates.first), 4);
+        putInt(records, std::uint32_t(chunkCoordinates.second), 4);
+        putInt(records, blob.size(), 4);
+        putInt(records, checksum(records.data() + start, 12) + checksum(blob.data(), blob.size()), 4);
+        records.append(blob);
+    }
+
+    // Anything past the valid part is a torn record, which is written over
+    int descriptor = open(journalName(filename).c_str(), O_WRONLY | O_CREAT, 0644);
+    if (descriptor == -1) throw WorldFileWriteFailed();
+    bool written = ftruncate(descriptor, journalSize) == 0;
+    for (std::size_t done = 0; written && done < records.size();){
+        ssize_t count = pwrite(descriptor, records.data() + done, records.size() - done, journalSize + done);
+        written = count > 0;
+        done += written ? count : 0;
+    }
+    written = written && fsync(descriptor) == 0;
+    close(descriptor);
+    if (!written) throw WorldFileWriteFailed();
+
+    journalSize += records.size();
+    for (auto entry : recorded){
+        auto& [chunkCoordinates, chunk] = *entry;
+        if (journaled.insert_or_assign(chunkCoordinates, chunk).second && !inFile(chunkCoordinates)) journaledOnly++;
+    }
+}
+
+WorldFile::Mapping::~Mapping(){
+    if (data != nullptr) munmap(const_cast<char*>(data), size);
+}
+
+void WorldFile::map(){
+    int descriptor = open(filename.c_str(), O_RDONLY);
+    if (descriptor == -1) throw InvalidWorldFile();
+    struct stat status;
+    if (fstat(descriptor, &status) == -1){
+        close(descriptor);
+        throw InvalidWorldFile();
+    }
+
+    std::size_t chunksStart = headerSize + mappedCount*mappedEntrySize;
+    if (std::size_t(status.st_size) < chunksStart + mappedCount*sizeof(Chunk)){
+        close(descriptor);
+        throw InvalidWorldFile();
+    }
+
+    void* mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapped == MAP_FAILED) throw InvalidWorldFile();
+    mapping.data = static_cast<const char*>(mapped);
+    mapping.size = status.st_size;
+    mappedIndex = mapping.data + headerSize;
+    mappedChunks = reinterpret_cast<const Chunk*>(mapping.data + chunksStart);
+}
+
+bool WorldFile::isWorldFile(const std::string& filename){
+    std::ifstream file(filename, std::ios::binary);
+    char start[4];
+    return file.read(start, 4) && std::memcmp(start, magic, 4) == 0;
+}
+
+std::string WorldFile::encode(const Chunk& chunk){
+    std::array<char, maxBlobSize> buffer;
+    char* out = buffer.data();
+    bool full = chunk.count() == Chunk::area;
+    *out++ = char(full ? fullChunk : 0);
+    if (!full){
+        for (auto& word : chunk.present) for (int i = 0; i < 8; i++) *out++ = char(word >> (8*i));
+    }
+
+    // Biomes come in large splotches, so a chunk holds a handful of distinct tiles in long runs
+    std::array<char, 256> palette;
+    int paletteSize = 0;
+    // Palette entries by packed tile byte, so tiles are only converted to stored bytes once each
+    std::array<std::int16_t, 256> entryOf;
+    entryOf.fill(-1);
+    std::array<std::uint16_t, Chunk::area> lengths;
+    std::array<std::uint8_t, Chunk::area> entries;
+    int runs = 0;
+    auto addRun = [&](std::uint8_t value, const Tile& tile, int length){
+        if (entryOf[value] == -1){
+            entryOf[value] = paletteSize;
+            palette[paletteSize++] = char(tileByte(tile));
+        }
+        lengths[runs] = length;
+        entries[runs++] = entryOf[value];
+    };
+    // Tiles are compared by their packed byte, which is the same for the same tile
+    auto packed = [&chunk](int index){
+        std::uint8_t value;
+        std::memcpy(&value, &chunk.tiles[index], 1);
+        return value;
+    };
+
+    if (full){
+        for (int start = 0; start < Chunk::area;){
+            std::uint8_t value = packed(start);
+            std::uint64_t repeated = value*0x0101010101010101ULL;
+            int end = start + 1;
+            // Tiles are single bytes, so runs are skipped through eight at a time
+            while (end + 8 <= Chunk::area){
+                std::uint64_t word;
+                std::memcpy(&word, &chunk.tiles[end], 8);
+                if (word != repeated) break;
+                end += 8;
+            }
+            while (end < Chunk::area && packed(end) == value) end++;
+            addRun(value, chunk.tiles[start], end - start);
+            start = end;
+        }
+    }
+    else {
+        int start = 0;
+        int length = 0;
+        for (int i = 0; i < Chunk::area; i++){
+            if (!chunk.contains(i)) continue;
+            if (length > 0 && packed(i) == packed(start)){
+                length++;
+                continue;
+            }
+            if (length > 0) addRun(packed(start), chunk.tiles[start], length);
+            start = i;
+            length = 1;
+        }
+        if (length > 0) addRun(packed(start), chunk.tiles[start], length);
+    }
+
+    putVarint(out, paletteSize);
+    out = std::copy(palette.begin(), palette.begin() + paletteSize, out);
+    if (paletteSize > 1){
+        int bits = paletteBits(paletteSize);
+        for (int i = 0; i < runs; i++) putVarint(out, (std::uint64_t(lengths[i] - 1) << bits) | entries[i]);
+    }
+    return std::string(buffer.data(), out);
+}
+
+Chunk WorldFile::decode(const std::string& blob){
+    constexpr std::size_t maskSize = Chunk::area/8;
+    const char* in = blob.data();
+    const char* end = in + blob.size();
+    if (in == end) throw InvalidWorldFile();
+    std::uint8_t flags = *in++;
+    if (flags & ~fullChunk) throw InvalidWorldFile();
+
+    Chunk chunk;
+    bool full = flags & fullChunk;
+    if (full) chunk.present.fill(~std::uint64_t(0));
+    else {
+        if (std::size_t(end - in) < maskSize) throw InvalidWorldFile();
+        for (std::size_t i = 0; i < chunk.present.size(); i++) chunk.present[i] = getInt(in + 8*i, 8);
+        in += maskSize;
+    }
+    int tiles = full ? Chunk::area : chunk.count();
+
+    std::uint64_t paletteSize = getVarint(in, end);
+    if (paletteSize > std::uint64_t(tiles) || paletteSize > 256 || std::uint64_t(end - in) < paletteSize) throw InvalidWorldFile();
+    if (tiles > 0 && paletteSize == 0) throw InvalidWorldFile();
+    std::array<Tile, 256> palette;
+    for (std::uint64_t i = 0; i < paletteSize; i++) palette[i] = byteTile(std::uint8_t(in[i]));
+    in += paletteSize;
+
+    // Runs cover the present tiles in order, so full chunks are filled a run at a time
+    int bits = paletteBits(paletteSize);
+    int covered = 0;
+    int position = 0;
+    while (covered < tiles){
+        std::uint64_t slot = 0;
+        std::uint64_t run = tiles;
+        if (paletteSize > 1){
+            std::uint64_t token = getVarint(in, end);
+            slot = token & ((std::uint64_t(1) << bits) - 1);
+            run = (token >> bits) + 1;
+            if (slot >= paletteSize || run > std::uint64_t(tiles - covered)) throw InvalidWorldFile();
+        }
+        const Tile& tile = palette[slot];
+        if (full){
+            std::fill(chunk.tiles.begin() + covered, chunk.tiles.begin() + covered + run, tile);
+        }
+        else {
+            for (std::uint64_t i = 0; i < run; i++){
+                while (!chunk.contains(position)) position++;
+                chunk.tiles[position++] = tile;
+            }
+        }
+        covered += run;
+    }
+    if (in != end) throw InvalidWorldFile();
+    return chunk;
+}
+
+void WorldFile::collectBlobs(std::vector<std::pair<std::pair<int,int>, std::string>>& blobs, Layout target, const Board* board){
+    for (auto& chunkCoordinates : getChunks()){
+        if (board != nullptr && board->getChunk(chunkCoordinates) != nullptr) continue;
+        auto journaledChunk = journaled.find(chunkCoordinates);
+        if (journaledChunk != journaled.end()){
+            blobs.emplace_back(chunkCoordinates, storeChunk(journaledChunk->second, chunkCoordinates, target, seed));
+            continue;
+        }
+        if (layout == Layout::mapped){
+            blobs.emplace_back(chunkCoordinates, storeChunk(*findMapped(chunkCoordinates), chunkCoordinates, target, seed));
+            continue;
+        }
+        blobs.emplace_back(chunkCoordinates, std::string());
+        readBlob(chunkCoordinates, blobs.back().second);
+        if (target != layout){
+            blobs.back().second = storeChunk(decodeBlob(chunkCoordinates, blobs.back().second), chunkCoordinates, target, seed);
+        }
+    }
+}
+
+void WorldFile::write(const Board& board, const std::string& filename, Layout layout){
+    std::vector<std::pair<std::pair<int,int>, std::string>> blobs;
+    board.forEachChunk([&](std::pair<int,int> chunkCoordinates, const Chunk& chunk){
+        if (layout == Layout::delta && board.chunkPristine(chunkCoordinates)) return;
+        blobs.emplace_back(chunkCoordinates, storeChunk(chunk, chunkCoordinates, layout, board.getSeed()));
+    });
+    std::shared_ptr<WorldFile> source = board.getSource();
+    if (source != nullptr) source->collectBlobs(blobs, layout, &board);
+    writeBlobs(board.getSeed(), blobs, filename, layout);
+}
+
+void WorldFile::write(int seed, const std::vector<std::pair<std::pair<int,int>, Chunk>>& chunks, const std::string& filename, Layout layout){
+    std::vector<std::pair<std::pair<int,int>, std::string>> blobs;
+    blobs.reserve(chunks.size());
+    for (auto& [chunkCoordinates, chunk] : chunks) blobs.emplace_back(chunkCoordinates, storeChunk(chunk, chunkCoordinates, layout, seed));
+    writeBlobs(seed, blobs, filename, layout);
+}
+
+void WorldFile::compact(const std::string& filename){
+    std::vector<std::pair<std::pair<int,int>, std::string>> blobs;
+    int seed;
+    Layout layout;
+    {
+        WorldFile file(filename);
+        file.collectBlobs(blobs, file.layout, nullptr);
+        seed = file.seed;
+        layout = file.layout;
+    }
+    writeBlobs(seed, blobs, filename, layout);
+}
+
+void WorldFile::writeBlobs(int seed, std::vector<std::pair<std::pair<int,int>, std::string>>& blobs, const std::string& filename, Layout layout){
+    blobs.erase(std::remove_if(blobs.begin(), blobs.end(), [](const auto& blob){return blob.second.empty();}), blobs.end());
+    std::sort(blobs.begin(), blobs.end(), [](const auto& lhs, const auto& rhs){return lhs.first < rhs.first;});
+
+    std::string entries;
+    std::pair<int,int> previous = std::make_pair(0,0);
+    for (auto& [chunkCoordinates, blob] : blobs){
+        if (layout == Layout::mapped){
+            std::int32_t coordinates[2] = {chunkCoordinates.first, chunkCoordinates.second};
+            entries.append(reinterpret_cast<const char*>(coordinates), sizeof(coordinates));
+            continue;
+        }
+        // Sorted chunks are mostly next to the previous one, so deltas are a byte each
+        putVarint(entries, zigzag(std::int64_t(chunkCoordinates.first) - previous.first));
+        putVarint(entries, zigzag(std::int64_t(chunkCoordinates.second) - previous.second));
+        putVarint(entries, blob.size());
+        previous = chunkCoordinates;
+    }
+
+    std::string header(magic, 4);
+    putInt(header, version, 4);
+    putInt(header, std::uint32_t(seed), 4);
+    putInt(header, blobs.size(), 4);
+    putInt(header, std::uint32_t(layout), 4);
+    header.append(reinterpret_cast<const char*>(&byteOrder), sizeof(byteOrder));
+    putInt(header, newStamp(), 8);
+    putInt(header, entries.size(), 8);
+    header.append(entries);
+
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream ofile(temporary, std::ios::binary | std::ios::trunc);
+        ofile.write(header.data(), header.size());
+        for (auto& [chunkCoordinates, blob] : blobs) ofile.write(blob.data(), blob.size());
+        if (!ofile.flush()) throw WorldFileWriteFailed();
+    }
+    syncFile(temporary);
+    std::filesystem::rename(temporary, filename);
+
+    // The new stamp already makes the journal stale, this only tidies it away
+    std::error_code ignored;
+    std::filesystem::remove(journalName(filename), ignored);
+}
+
+int WorldFile::getSeed() const {return seed;}
+
+const std::string& WorldFile::getFilename() const {return filename;}
+
+WorldFile::Layout WorldFile::getLayout() const {return layout;}
+
+std::size_t WorldFile::size() const {
+    return (layout == Layout::mapped ? mappedCount : index.size()) + journaledOnly;
+}
+
+bool WorldFile::inFile(std::pair<int,int> chunkCoordinates) const {
+    if (layout == Layout::mapped) return findMapped(chunkCoordinates) != nullptr;
+    return index.count(chunkCoordinates);
+}
+
+bool WorldFile::contains(std::pair<int,int> chunkCoordinates) const {
+    return journaled.count(chunkCoordinates) || inFile(chunkCoordinates);
+}
+
+std::vector<std::pair<int,int>> WorldFile::getChunks() const {
+    std::vector<std::pair<int,int>> chunks;
+    chunks.reserve(size());
+    if (layout == Layout::mapped){
+        for (std::size_t i = 0; i < mappedCount; i++){
+            const char* entry = mappedIndex + i*mappedEntrySize;
+            chunks.emplace_back(nativeInt(entry), nativeInt(entry + 4));
+        }
+    }
+    else {
+        for (auto& [chunkCoordinates, entry] : index) chunks.push_back(chunkCoordinates);
+    }
+    for (auto& [chunkCoordinates, chunk] : journaled) if (!inFile(chunkCoordinates)) chunks.push_back(chunkCoordinates);
+    return chunks;
+}
+
+const Chunk* WorldFile::findChunk(std::pair<int,int> chunkCoordinates) const {
+    auto journaledChunk = journaled.find(chunkCoordinates);
+    if (journaledChunk != journaled.end()) return &journaledChunk->second;
+    return findMapped(chunkCoordinates);
+}
+
+const Chunk* WorldFile::findMapped(std::pair<int,int> chunkCoordinates) const {
+    std::size_t low = 0;
+    std::size_t high = mappedCount;
+    while (low < high){
+        std::size_t middle = (low + high)/2;
+        const char* entry = mappedIndex + middle*mappedEntrySize;
+        auto here = std::make_pair(int(nativeInt(entry)), int(nativeInt(entry + 4)));
+        if (here == chunkCoordinates) return &mappedChunks[middle];
+        if (here < chunkCoordinates) low = middle + 1;
+        else high = middle;
+    }
+    return nullptr;
+}
+
+bool WorldFile::readBlob(std::pair<int,int> chunkCoordinates, std::string& blob){
+    auto entry = index.find(chunkCoordinates);
+    if (entry == index.end()) return false;
+
+    blob.resize(entry->second.size);
+    std::lock_guard lock(mutex);
+    file.clear();
+    if (!file.seekg(entry->second.offset) || !file.read(blob.data(), blob.size())) throw InvalidWorldFile();
+    return true;
+}
+
+bool WorldFile::read(std::pair<int,int> chunkCoordinates, Chunk& chunk){
+    if (layout == Layout::mapped || journaled.count(chunkCoordinates)){
+        const Chunk* found = findChunk(chunkCoordinates);
+        if (found == nullptr) return false;
+        chunk = *found;
+        return true;
+    }
+
+    std::string blob;
+    if (!readBlob(chunkCoordinates, blob)) return false;
+    chunk = decodeBlob(chunkCoordinates, blob);
+    return true;
+}
+
+Chunk WorldFile::decodeBlob(std::pair<int,int> chunkCoordinates, const std::string& blob) const {
+    Chunk chunk = decode(blob);
+    if (layout != Layout::delta) return chunk;
+    return applyDifference(Generator(seed).generateChunk(chunkCoordinates), chunk);
+}
\ No newline at end of file
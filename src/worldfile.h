@@ -0,0 +1,324 @@
+#ifndef WORLD_FILE
+#define WORLD_FILE
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "board.h"
+#include "chunk.h"
+
+/**
+ * @brief A saved world, read one chunk at a time
+ * 
+ * The file holds a header (magic, version, seed, chunk count, layout, stamp and
+ * index size), an index of every chunk sorted by coordinates, then the chunks
+ * themselves.
+ * 
+ * In the packed layout, the index holds each chunk's coordinates as varint deltas
+ * from the previous entry and the size of its blob, and the blobs follow in index
+ * order. Each blob is a flags byte, the presence mask (left out for full chunks),
+ * a palette of the distinct tiles in the chunk, then the tiles as runs of palette
+ * entries, each a single varint. Opening the file reads the header and index, and
+ * any chunk can then be read on its own. Files from other versions are rejected.
+ * 
+ * In the mapped layout, the index holds only coordinates, and each chunk is stored
+ * exactly as it is in memory, in index order. The file is memory-mapped and chunks
+ * are used in place, so opening it costs the same whatever its size. Mapped files
+ * are only readable on machines with the same byte order and Tile packing.
+ * 
+ * The delta layout is the packed layout, except each blob only holds the tiles
+ * that differ from what the Generator makes for the file's seed, and chunks that
+ * don't differ at all are left out. Reading a chunk generates it and lays the
+ * stored tiles over it, and chunks that aren't in the file are generated as usual,
+ * so the file only grows with what changed, not with how much was explored. It
+ * relies on the generator making the same chunks for a seed in every version.
+ * 
+ * Chunks changed since the file was written can be appended to a journal next
+ * to it (the file's name followed by .journal) instead of rewriting the whole
+ * file. Journal records are checksummed and replayed over the file when it is
+ * opened, stopping at the first incomplete one, so a crash while appending only
+ * loses that append. The journal starts with the stamp of the file it belongs
+ * to, and is ignored once the file is written again.
+ * 
+ * Reads are safe from several threads at once.
+ */
+class WorldFile{
+public:
+    /** How chunks are stored */
+    enum class Layout {packed, mapped, delta};
+
+private:
+    /** Where a chunk's blob is stored */
+    struct Entry{
+        /** Position of the blob from the start of the file */
+        std::uint64_t offset;
+        /** Size of the blob in bytes */
+        std::uint32_t size;
+    };
+
+    /** A read-only mapping of a file, unmapped when destroyed */
+    struct Mapping{
+        /** Start of the mapping */
+        const char* data = nullptr;
+        /** Size of the mapping in bytes */
+        std::size_t size = 0;
+
+        Mapping() = default;
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+        ~Mapping();
+    };
+
+    /** Name of the file */
+    std::string filename;
+    /** Open file */
+    std::ifstream file;
+    /** Guards reads of the file */
+    std::mutex mutex;
+    /** Seed of the saved board */
+    int seed;
+    /** Layout of the file */
+    Layout layout = Layout::packed;
+    /** Changes with every write, journals written against another stamp are ignored */
+    std::uint64_t stamp = 0;
+    /** Blobs by chunk coordinates (packed layout) */
+    std::unordered_map<std::pair<int,int>, Entry, CoordinateHash> index;
+    /** The mapped file (mapped layout), released even if opening fails after mapping it */
+    Mapping mapping;
+    /** Number of chunks (mapped layout) */
+    std::size_t mappedCount = 0;
+    /** Sorted chunk coordinates in the mapping, as pairs of 32 bit integers (mapped layout) */
+    const char* mappedIndex = nullptr;
+    /** Chunks in the mapping, in index order (mapped layout) */
+    const Chunk* mappedChunks = nullptr;
+    /** Chunks replayed from the journal, which take precedence over the file */
+    std::unordered_map<std::pair<int,int>, Chunk, CoordinateHash> journaled;
+    /** Number of journaled chunks that aren't in the file itself */
+    std::size_t journaledOnly = 0;
+    /** Size in bytes of the valid part of the journal */
+    std::size_t journalSize = 0;
+
+    /**
+     * @brief Map the file and locate its index and chunks
+     * 
+     * @throws InvalidWorldFile if the file can't be mapped or doesn't fit its header
+     */
+    void map();
+
+    /**
+     * @brief Read the journal, keeping every complete record written against this file
+     * 
+     */
+    void replayJournal();
+
+    /**
+     * @brief Check if a chunk is in the file itself, ignoring the journal
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Whether or not the chunk is in the file
+     */
+    bool inFile(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Find a chunk in the mapping, ignoring the journal (mapped layout only)
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Pointer to the chunk in the mapping, or nullptr if it isn't there
+     */
+    const Chunk* findMapped(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Add the stored form of every chunk in the file (and journal) to a list of blobs
+     * 
+     * @param blobs Filled with chunk coordinates and blobs
+     * @param target Layout the blobs are for
+     * @param board Chunks on this board are skipped (if not nullptr)
+     */
+    void collectBlobs(std::vector<std::pair<std::pair<int,int>, std::string>>& blobs, Layout target, const Board* board);
+
+    /**
+     * @brief Write a world file from blobs already in its layout, and drop its journal
+     * 
+     * @param seed Seed of the saved board
+     * @param blobs Chunk coordinates and blobs (sorted in place)
+     * @param filename Name of the file
+     * @param layout Layout of the blobs
+     * @throws WorldFileWriteFailed if the file can't be written
+     */
+    static void writeBlobs(int seed, std::vector<std::pair<std::pair<int,int>, std::string>>& blobs, const std::string& filename, Layout layout);
+
+    /**
+     * @brief Read the stored blob of a chunk
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param blob Filled with the blob
+     * @return Whether or not the chunk is in the file
+     */
+    bool readBlob(std::pair<int,int> chunkCoordinates, std::string& blob);
+
+    /**
+     * @brief Decode a blob stored in the file (or its journal) into the chunk it stands for
+     * 
+     * Deltas are laid over the generated chunk.
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param blob Blob to decode
+     * @return Chunk
+     * @throws InvalidWorldFile if the blob is damaged
+     */
+    Chunk decodeBlob(std::pair<int,int> chunkCoordinates, const std::string& blob) const;
+
+public:
+    /** Marks the start of a world file */
+    static constexpr char magic[4] = {'M','T','G','W'};
+    /** Version of the format written */
+    static constexpr std::uint32_t version = 4;
+
+    /**
+     * @brief Open a world file, reading its header and index
+     * 
+     * @param filename Name of the file
+     * @throws InvalidWorldFile if the file can't be read or isn't a world file
+     */
+    WorldFile(const std::string& filename);
+
+    WorldFile(const WorldFile&) = delete;
+    WorldFile& operator=(const WorldFile&) = delete;
+
+    /**
+     * @brief Check if a file starts like a world file
+     * 
+     * @param filename Name of the file
+     * @return Whether or not the file is a world file
+     */
+    static bool isWorldFile(const std::string& filename);
+
+    /**
+     * @brief Write a board to a world file
+     * 
+     * Chunks of the board's own world file that were never paged in are copied
+     * over. The file is written under a temporary name, flushed to disk and renamed
+     * over the old one once complete, so the old file stays intact (and readable by
+     * anything that has it open) if writing fails.
+     * 
+     * @param board Board to write
+     * @param filename Name of the file
+     * @param layout How to store chunks
+     * @throws WorldFileWriteFailed if the file can't be written
+     */
+    static void write(const Board& board, const std::string& filename, Layout layout = Layout::packed);
+
+    /**
+     * @brief Write chunks to a world file
+     * 
+     * @param seed Seed of the board the chunks are from
+     * @param chunks Chunk coordinates and chunks
+     * @param filename Name of the file
+     * @param layout How to store chunks
+     * @throws WorldFileWriteFailed if the file can't be written
+     */
+    static void write(int seed, const std::vector<std::pair<std::pair<int,int>, Chunk>>& chunks, const std::string& filename, Layout layout = Layout::packed);
+
+    /**
+     * @brief Rewrite a world file with its journal folded in, in the same layout
+     * 
+     * @param filename Name of the file
+     * @throws InvalidWorldFile if the file can't be read
+     * @throws WorldFileWriteFailed if the file can't be written
+     */
+    static void compact(const std::string& filename);
+
+    /**
+     * @brief Append chunks to the file's journal and flush it to disk
+     * 
+     * The chunks are read back from the journal from then on. Must not be called
+     * while other threads are reading.
+     * 
+     * @param chunks Chunk coordinates and chunks
+     * @throws WorldFileWriteFailed if the journal can't be written
+     */
+    void append(const std::vector<std::pair<std::pair<int,int>, Chunk>>& chunks);
+
+    /**
+     * @brief Encode a chunk into a blob
+     * 
+     * @param chunk Chunk to encode
+     * @return Blob
+     */
+    static std::string encode(const Chunk& chunk);
+
+    /**
+     * @brief Decode a blob into a chunk
+     * 
+     * @param blob Blob to decode
+     * @return Chunk
+     * @throws InvalidWorldFile if the blob is damaged
+     */
+    static Chunk decode(const std::string& blob);
+
+    /**
+     * @brief Get the seed of the saved board
+     * 
+     * @return Seed
+     */
+    int getSeed() const;
+
+    /**
+     * @brief Get the name of the file
+     * 
+     * @return Name of the file
+     */
+    const std::string& getFilename() const;
+
+    /**
+     * @brief Get the layout of the file
+     * 
+     * @return Layout
+     */
+    Layout getLayout() const;
+
+    /**
+     * @brief Get the number of chunks in the file
+     * 
+     * @return Number of chunks
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Check if a chunk is in the file
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Whether or not the chunk is in the file
+     */
+    bool contains(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Get the coordinates of every chunk in the file
+     * 
+     * @return Chunk coordinates, in no particular order
+     */
+    std::vector<std::pair<int,int>> getChunks() const;
+
+    /**
+     * @brief Find a chunk in place (mapped layout, or chunks in the journal)
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @return Pointer to the chunk (valid while the file is open and nothing is appended), or nullptr if it isn't there
+     */
+    const Chunk* findChunk(std::pair<int,int> chunkCoordinates) const;
+
+    /**
+     * @brief Read a chunk
+     * 
+     * @param chunkCoordinates Coordinates of the chunk
+     * @param chunk Filled with the chunk
+     * @return Whether or not the chunk is in the file
+     * @throws InvalidWorldFile if the chunk can't be read
+     */
+    bool read(std::pair<int,int> chunkCoordinates, Chunk& chunk);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include "../src/autosaver.h"
+#include "../src/board.h"
+#include "../src/utility.h"
+#include "../src/worldfile.h"
+
+int countChunks(const Board& board){
+    int chunks = 0;
+    board.forEachChunk([&](std::pair<int,int>, const Chunk&){chunks++;});
+    return chunks;
+}
+
+TEST(DirtyChunks, GeneratedAndAdded){
+    Board board(3);
+    board.takeDirtyChunks();
+    board.generateRegion(std::make_pair(100,100), 10);
+
+    auto chunks = board.takeDirtyChunks();
+    EXPECT_EQ(chunks.size(), 4);
+    for (auto& [chunkCoordinates, chunk] : chunks) EXPECT_EQ(chunk.count(), board.getChunk(chunkCoordinates)->count());
+    EXPECT_TRUE(board.takeDirtyChunks().empty());
+
+    // Generating chunks that are already complete changes nothing
+    board.generateRegion(std::make_pair(100,100), 10);
+    EXPECT_TRUE(board.takeDirtyChunks().empty());
+
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    board.addChunk(std::make_pair(-40,-40), custom);
+    chunks = board.takeDirtyChunks();
+    ASSERT_EQ(chunks.size(), 1);
+    EXPECT_EQ(chunks[0].first, std::make_pair(-40,-40));
+}
+
+TEST(DirtyChunks, JsonLoad){
+    std::string filename = "dirtyjson";
+    Board toSave(3);
+    toSave.generateRegion(std::make_pair(300,300), 10);
+    save(toSave, filename, true);
+
+    // Only the chunks read are dirty, not those of the board they were read into
+    Board loaded = load(filename, std::make_pair(300,300), true);
+    std::set<std::pair<int,int>> expected;
+    loaded.forEachChunk([&](std::pair<int,int> chunkCoordinates, const Chunk&){expected.insert(chunkCoordinates);});
+    std::set<std::pair<int,int>> chunks;
+    for (auto& [chunkCoordinates, chunk] : loaded.takeDirtyChunks()) chunks.insert(chunkCoordinates);
+    EXPECT_EQ(chunks, expected);
+    EXPECT_EQ(chunks.size(), countChunks(toSave));
+    EXPECT_TRUE(loaded.takeDirtyChunks().empty());
+
+    filename.append(".save.json");
+    std::remove(filename.c_str());
+}
+
+TEST(Autosaver, SavesChangedChunks){
+    auto position = std::make_pair(0,0);
+    std::string filename = "autosave.save";
+    Board board(7);
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    {
+        Autosaver autosaver(board, "autosave", std::chrono::hours(1));
+        EXPECT_EQ(WorldFile(filename).size(), 0);
+
+        // Generated chunks are left to be generated again on load
+        board.generateRegion(std::make_pair(200,-200), 20);
+        autosaver.snapshot(board);
+        EXPECT_EQ(autosaver.pendingChunks(), 0);
+
+        board.addChunk(std::make_pair(-20,-20), custom);
+        board.addChunk(std::make_pair(30,-30), custom);
+        autosaver.snapshot(board);
+        EXPECT_EQ(autosaver.pendingChunks(), 2);
+        autosaver.flush();
+        EXPECT_EQ(autosaver.pendingChunks(), 0);
+        EXPECT_TRUE(std::filesystem::exists(filename + ".journal"));
+        EXPECT_EQ(WorldFile(filename).size(), 2);
+
+        // Whatever is still pending is written when the autosaver stops
+        board.addChunk(std::make_pair(-30,30), custom);
+        autosaver.snapshot(board);
+    }
+
+    Board loaded = load("autosave", position);
+    EXPECT_EQ(loaded.getSource()->size(), 3);
+    loaded.generateRegion(std::make_pair(480,-480), 0);
+    loaded.generateRegion(std::make_pair(-480,480), 0);
+    EXPECT_EQ(loaded.getTile(std::make_pair(480,-480)).getBiome(), TileGen::desert);
+    EXPECT_EQ(loaded.getTile(std::make_pair(-480,480)).getBiome(), TileGen::desert);
+    loaded.generateRegion(std::make_pair(200,-200), 20, 1);
+    EXPECT_EQ(loaded.getTile(std::make_pair(210,-190)).getBiome(), board.getTile(std::make_pair(210,-190)).getBiome());
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".journal").c_str());
+}
+
+TEST(Autosaver, ResumesLoadedSaveAndCompacts){
+    auto position = std::make_pair(0,0);
+    std::string filename = "autosaveresume.save";
+    Board toSave(7);
+    save(toSave, "autosaveresume");
+
+    Board board = load("autosaveresume", position);
+    std::size_t saved = board.getSource()->size();
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    {
+        // The board came from this save, so only its changes are written
+        Autosaver autosaver(board, "autosaveresume", std::chrono::hours(1), 2);
+        board.addChunk(std::make_pair(6,0), custom);
+        autosaver.snapshot(board);
+        autosaver.flush();
+        EXPECT_TRUE(std::filesystem::exists(filename + ".journal"));
+
+        board.addChunk(std::make_pair(12,0), custom);
+        autosaver.snapshot(board);
+        autosaver.flush();
+        EXPECT_FALSE(std::filesystem::exists(filename + ".journal"));
+    }
+
+    WorldFile file(filename);
+    EXPECT_EQ(file.size(), saved + 2);
+    EXPECT_TRUE(file.contains(std::make_pair(12,0)));
+
+    std::remove(filename.c_str());
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "../src/board.h"
+#include "../src/global.h"
 #include "../src/interface.h"
+#include "../src/searcharena.h"
 #include "../src/utility.h"
 
 class PathToEnvironment : public ::testing::Environment {
@@ -71,7 +73,6 @@ TEST(PathToNoCost, CoordinatesUselessSkip){
 
 TEST(PathToNoCost, Biome){
     TestPathToDefaults p;
-    TileGen tileGen;
     p.biome = tileGen.plains;
 
     int expectedTilesTraversed = 1;
@@ -85,7 +86,6 @@ TEST(PathToNoCost, Biome){
 
 TEST(PathToNoCost, BiomeSkip){
     TestPathToDefaults p;
-    TileGen tileGen;
     p.biome = tileGen.plains;
     p.toSkip = 7;
 
@@ -100,7 +100,6 @@ TEST(PathToNoCost, BiomeSkip){
 
 TEST(PathToNoCost, BiomeFar){
     TestPathToDefaults p;
-    TileGen tileGen;
     p.biome = tileGen.mountains;
 
     int expectedTilesTraversed = 10;
@@ -114,7 +113,6 @@ TEST(PathToNoCost, BiomeFar){
 
 TEST(PathToNoCost, BiomeCannotFind){
     TestPathToDefaults p;
-    TileGen tileGen;
     p.biome = tileGen.ocean;
     p.maxDistance = 100;
 
@@ -128,7 +126,6 @@ TEST(PathToNoCost, BiomeCannotFind){
 
 TEST(PathToNoCost, Feature){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.lake;
 
     int expectedTilesTraversed = 11;
@@ -142,7 +139,6 @@ TEST(PathToNoCost, Feature){
 
 TEST(PathToNoCost, FeatureSkip){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.lake;
     p.toSkip = 3;
 
@@ -157,7 +153,6 @@ TEST(PathToNoCost, FeatureSkip){
 
 TEST(PathToNoCost, FeatureNone){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.none;
 
     int expectedTilesTraversed = 1;
@@ -171,7 +166,6 @@ TEST(PathToNoCost, FeatureNone){
 
 TEST(PathToNoCost, FeatureAny){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.any;
 
     int expectedTilesTraversed = 4;
@@ -185,7 +179,6 @@ TEST(PathToNoCost, FeatureAny){
 
 TEST(PathToNoCost, FeatureAnySkip){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.any;
     p.toSkip = 31;
 
@@ -200,7 +193,6 @@ TEST(PathToNoCost, FeatureAnySkip){
 
 TEST(PathToNoCost, FeatureAnyCannotFind){
     TestPathToDefaults p;
-    FeatureGen featGen;
     p.feature = featGen.any;
     p.maxDistance = 19;
     p.toSkip = 31;
@@ -211,4 +203,153 @@ TEST(PathToNoCost, FeatureAnyCannotFind){
     auto calculatedPath = board.pathTo(p.start, p.biome, p.feature, p.ignoreTravelCost, p.maxDistance, p.toSkip);
 
     EXPECT_EQ(calculatedPath.tilesTraversed, expectedTilesTraversed);
+}
+
+TEST(FindPath, CoordinatesFullRoute){
+    TestPathToDefaults p;
+    p.end = std::make_pair(3,5);
+
+    Board board = load("pathTo", p.start);
+    auto calculatedPath = board.findPath(p.start, p.end, p.ignoreTravelCost, p.maxDistance);
+
+    EXPECT_EQ(calculatedPath.tilesTraversed, 8);
+    ASSERT_EQ(calculatedPath.steps.size(), 8);
+    auto previous = p.start;
+    for (auto& here : calculatedPath.steps){
+        EXPECT_EQ(std::abs(here.first - previous.first) + std::abs(here.second - previous.second), 1);
+        previous = here;
+    }
+    EXPECT_EQ(calculatedPath.steps.back(), p.end);
+}
+
+TEST(FindPath, TravelCostMatchesDijkstra){
+    TestPathToDefaults p;
+    p.end = std::make_pair(-6,4);
+    p.ignoreTravelCost = false;
+    p.maxDistance = 1000;
+
+    Board board = load("pathTo", p.start);
+    auto aStar = board.findPath(p.start, p.end, p.ignoreTravelCost, p.maxDistance);
+    auto dijkstra = board.findPath(p.start, p.end, p.ignoreTravelCost, p.maxDistance, [](std::pair<int,int>, std::pair<int,int>){return 0;});
+
+    ASSERT_NE(aStar.tilesTraversed, -1);
+    EXPECT_EQ(aStar.travelCost, dijkstra.travelCost);
+
+    int travelCost = 0;
+    for (auto& here : aStar.steps){
+        travelCost += board.getTile(here).getTravelCost();
+        if (here != p.end){
+            EXPECT_TRUE(board.getTile(here).isTravellable());
+        }
+    }
+    EXPECT_EQ(aStar.travelCost, travelCost);
+}
+
+TEST(FindPath, TravelCostBrokenDistance){
+    TestPathToDefaults p;
+    p.end = std::make_pair(3,5);
+    p.ignoreTravelCost = false;
+    p.maxDistance = 5;
+
+    Board board = load("pathTo", p.start);
+    auto calculatedPath = board.findPath(p.start, p.end, p.ignoreTravelCost, p.maxDistance);
+
+    EXPECT_EQ(calculatedPath.tilesTraversed, -1);
+    EXPECT_TRUE(calculatedPath.steps.empty());
+}
+TEST(PathTo, FeatureFullRoute){
+    TestPathToDefaults p;
+    p.feature = featGen.any;
+    p.toSkip = 3;
+
+    Board board = load("pathTo", p.start);
+    auto calculatedPath = board.pathTo(p.start, p.biome, p.feature, p.ignoreTravelCost, p.maxDistance, p.toSkip);
+
+    ASSERT_NE(calculatedPath.tilesTraversed, -1);
+    ASSERT_EQ(calculatedPath.steps.size(), calculatedPath.tilesTraversed);
+    auto previous = p.start;
+    int travelCost = 0;
+    for (auto& here : calculatedPath.steps){
+        EXPECT_EQ(std::abs(here.first - previous.first) + std::abs(here.second - previous.second), 1);
+        travelCost += board.getTile(here).getTravelCost();
+        previous = here;
+    }
+    EXPECT_EQ(calculatedPath.travelCost, travelCost);
+    EXPECT_NE(board.getTile(calculatedPath.steps.back()).getFeature(), featGen.none);
+}
+
+TEST(PathTo, ArenaReuse){
+    TestPathToDefaults p;
+    p.biome = tileGen.plains;
+    p.ignoreTravelCost = false;
+    p.maxDistance = 1000;
+
+    Board board = load("pathTo", p.start);
+    SearchArena arena;
+    for (int toSkip = 0; toSkip < 5; toSkip++){
+        Path expected = board.pathTo(p.start, p.biome, p.feature, p.ignoreTravelCost, p.maxDistance, toSkip);
+        const Path& reused = board.pathTo(arena, p.start, p.biome, p.feature, p.ignoreTravelCost, p.maxDistance, toSkip);
+
+        ASSERT_NE(reused.tilesTraversed, -1);
+        EXPECT_EQ(reused.steps, expected.steps);
+        EXPECT_EQ(reused.travelCost, expected.travelCost);
+        EXPECT_EQ(board.getTile(reused.steps.back()).getBiome(), p.biome);
+    }
+
+    const Path& coordinates = board.findPath(arena, p.start, std::make_pair(3,5), p.ignoreTravelCost, p.maxDistance);
+    EXPECT_EQ(coordinates.steps.back(), std::make_pair(3,5));
+}
+TEST(PathsTo, MatchesPathTo){
+    TestPathToDefaults p;
+    std::vector<PathQuery> queries = {
+        PathQuery{tileGen.plains, -1, p.start, 4},
+        PathQuery{-1, featGen.any, p.start, 3},
+        PathQuery{tileGen.desert, featGen.camp, p.start, 1},
+        PathQuery{-1, -1, std::make_pair(3,5), 2}
+    };
+
+    Board board = load("pathTo", p.start);
+    for (bool ignoreTravelCost : {true, false}){
+        int maxDistance = ignoreTravelCost ? p.maxDistance : 1000;
+        auto paths = board.pathsTo(p.start, queries, ignoreTravelCost, maxDistance);
+        ASSERT_EQ(paths.size(), queries.size());
+
+        for (std::size_t i = 0; i < queries.size(); i++){
+            const PathQuery& query = queries[i];
+            for (int toSkip = 0; toSkip < (int)paths[i].size(); toSkip++){
+                auto expected = board.pathTo(p.start, query.biome, query.feature, ignoreTravelCost, maxDistance, toSkip, query.end);
+                EXPECT_EQ(paths[i][toSkip].tilesTraversed, expected.tilesTraversed);
+                EXPECT_EQ(paths[i][toSkip].travelCost, expected.travelCost);
+                EXPECT_EQ(paths[i][toSkip].steps.back(), expected.steps.back());
+            }
+        }
+        EXPECT_EQ(paths[0].size(), 4);
+        EXPECT_EQ(paths[1].size(), 3);
+        EXPECT_EQ(paths[3].size(), 1);
+    }
+}
+
+TEST(PathsTo, CoordinatesMatchOnce){
+    Board board(5);
+    board.generateRegion(std::make_pair(0,0), 60);
+    auto end = std::make_pair(2,1);
+    SearchArena arena;
+
+    auto paths = board.pathsTo(arena, std::make_pair(0,0), {PathQuery{-1, -1, end, 3}}, true, 100);
+    ASSERT_EQ(paths[0].size(), 1);
+    EXPECT_EQ(paths[0][0].tilesTraversed, 3);
+    // The sweep stops at the coordinates instead of carrying on to maxDistance
+    EXPECT_LT(arena.size(), 100);
+}
+
+TEST(PathsTo, StartAndNoQueries){
+    TestPathToDefaults p;
+
+    Board board = load("pathTo", p.start);
+    EXPECT_TRUE(board.pathsTo(p.start, {}, p.ignoreTravelCost, p.maxDistance).empty());
+
+    auto paths = board.pathsTo(p.start, {PathQuery{-1, -1, p.start, 1}}, p.ignoreTravelCost, p.maxDistance);
+    ASSERT_EQ(paths[0].size(), 1);
+    EXPECT_EQ(paths[0][0].tilesTraversed, 0);
+    EXPECT_TRUE(paths[0][0].steps.empty());
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <cereal/archives/binary.hpp>
+#include "../src/chunk.h"
+#include "../src/exceptions.h"
+#include "../src/global.h"
+
+TEST(Tile, Packing){
+    EXPECT_EQ(sizeof(Tile), 1);
+
+    Tile tile(tileGen.mountains);
+    EXPECT_EQ(tile.getBiome(), tileGen.mountains);
+    EXPECT_EQ(tile.getFeature(), featGen.none);
+    EXPECT_FALSE(tile.isReady());
+    EXPECT_FALSE(tile.isTravellable());
+
+    tile.setFeature(featGen.lake);
+    tile.setReady(true);
+    EXPECT_EQ(tile.getBiome(), tileGen.mountains);
+    EXPECT_EQ(tile.getFeature(), featGen.lake);
+    EXPECT_TRUE(tile.isReady());
+
+    tile.setFeature(featGen.camp);
+    tile.setReady(false);
+    EXPECT_EQ(tile.getFeature(), featGen.camp);
+    EXPECT_FALSE(tile.isReady());
+    EXPECT_EQ(Tile(tileGen.desert).getTravelCost(), tileGen.biomeTravelCosts.at(tileGen.desert));
+
+    EXPECT_THROW(Tile(tileGen.mountains + 1), InvalidBiomeFound);
+    EXPECT_THROW(tile.setFeature(featGen.lake + 1), InvalidFeatureFound);
+}
+
+TEST(CoordinateHash, MirroredAndDiagonal){
+    CoordinateHash hash;
+    EXPECT_NE(coordinateKey(std::make_pair(3,-7)), coordinateKey(std::make_pair(-7,3)));
+    EXPECT_NE(hash(std::make_pair(3,-7)), hash(std::make_pair(-7,3)));
+    EXPECT_NE(hash(std::make_pair(1,1)), hash(std::make_pair(2,2)));
+    EXPECT_NE(hash(std::make_pair(0,0)), hash(std::make_pair(-1,-1)));
+
+    // Neighbours land in different buckets of a small table
+    std::set<std::size_t> buckets;
+    for (int i = 0; i < 4; i++) for (int j = 0; j < 4; j++) buckets.insert(hash(std::make_pair(i,j)) & 1023);
+    EXPECT_GE(buckets.size(), 14);
+}
+
+TEST(ChunkMap, ChunkCoordinates){
+    EXPECT_EQ(ChunkMap::chunkCoordinates(std::make_pair(0,0)), std::make_pair(0,0));
+    EXPECT_EQ(ChunkMap::chunkCoordinates(std::make_pair(Chunk::size-1,Chunk::size)), std::make_pair(0,1));
+    EXPECT_EQ(ChunkMap::chunkCoordinates(std::make_pair(-1,-Chunk::size)), std::make_pair(-1,-1));
+    EXPECT_EQ(ChunkMap::chunkCoordinates(std::make_pair(-Chunk::size-1,3)), std::make_pair(-2,0));
+}
+
+TEST(ChunkMap, LocalIndexRoundTrip){
+    for (int i = -40; i <= 40; i++){
+        for (int j = -40; j <= 40; j++){
+            auto here = std::make_pair(i,j);
+            int index = ChunkMap::localIndex(here);
+            EXPECT_GE(index, 0);
+            EXPECT_LT(index, Chunk::area);
+            EXPECT_EQ(ChunkMap::tileCoordinates(ChunkMap::chunkCoordinates(here), index), here);
+        }
+    }
+}
+
+TEST(ChunkMap, EmplaceDoesNotOverwrite){
+    ChunkMap map;
+    auto here = std::make_pair(-3,17);
+
+    EXPECT_FALSE(map.contains(here));
+    EXPECT_THROW(map.at(here), TileMissingException);
+    EXPECT_TRUE(map.emplace(here, Tile(tileGen.forest)));
+    EXPECT_FALSE(map.emplace(here, Tile(tileGen.ocean)));
+
+    EXPECT_TRUE(map.contains(here));
+    EXPECT_FALSE(map.contains(std::make_pair(-3,16)));
+    EXPECT_EQ(map.at(here).getBiome(), tileGen.forest);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(ChunkMap, SaveLoad){
+    ChunkMap toSave;
+    for (int i = -20; i <= 20; i += 3){
+        for (int j = -20; j <= 20; j += 5){
+            toSave.emplace(std::make_pair(i,j), Tile((i + j + 40) % 5));
+        }
+    }
+    toSave.at(std::make_pair(-20,-20)).setFeature(featGen.cave);
+
+    std::stringstream stream;
+    {
+        cereal::BinaryOutputArchive oarchive(stream);
+        oarchive(toSave);
+    }
+    ChunkMap toLoad;
+    {
+        cereal::BinaryInputArchive iarchive(stream);
+        iarchive(toLoad);
+    }
+
+    EXPECT_EQ(toLoad.size(), toSave.size());
+    toSave.forEach([&toLoad](std::pair<int,int> coordinates, const Tile& tile){
+        EXPECT_EQ(toLoad.at(coordinates).getBiome(), tile.getBiome());
+        EXPECT_EQ(toLoad.at(coordinates).getFeature(), tile.getFeature());
+    });
+    EXPECT_EQ(toLoad.at(std::make_pair(-20,-20)).getFeature(), featGen.cave);
+    EXPECT_EQ(toLoad.at(std::make_pair(1,0)).getBiome(), tileGen.forest);
+}
+
+TEST(ChunkMap, ViewCopyOnWrite){
+    Chunk stored;
+    stored.set(5, Tile(tileGen.forest));
+    ChunkMap map;
+    auto here = std::make_pair(0,5);
+    map.insertView(std::make_pair(0,0), &stored);
+
+    EXPECT_EQ(map.findChunk(std::make_pair(0,0)), &stored);
+    EXPECT_TRUE(map.contains(here));
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(std::as_const(map).at(here).getBiome(), tileGen.forest);
+
+    // Writing copies the chunk out of the view, leaving the stored chunk untouched
+    map.at(here).setFeature(1);
+    EXPECT_TRUE(map.emplace(std::make_pair(0,6), Tile(tileGen.ocean)));
+    EXPECT_NE(map.findChunk(std::make_pair(0,0)), &stored);
+    EXPECT_EQ(map.at(here).getFeature(), 1);
+    EXPECT_EQ(stored.tiles[5].getFeature(), 0);
+    EXPECT_FALSE(stored.contains(6));
+    EXPECT_EQ(map.size(), 2);
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include "../src/board.h"
+#include "../src/featureindex.h"
+#include "../src/global.h"
+#include "../src/searcharena.h"
+#include "../src/utility.h"
+
+std::vector<std::pair<int,std::pair<int,int>>> bruteForceFeatures(const Board& board, std::pair<int,int> position, int feature, int radius){
+    std::vector<std::pair<int,std::pair<int,int>>> found;
+    for (auto& here : getCoordinatesInRadius(position, radius)){
+        const Chunk* chunk = board.getChunk(ChunkMap::chunkCoordinates(here));
+        if (chunk == nullptr || !chunk->contains(ChunkMap::localIndex(here))) continue;
+        int tileFeature = chunk->tiles[ChunkMap::localIndex(here)].getFeature();
+        if (tileFeature == featGen.none || (tileFeature != feature && feature != featGen.any)) continue;
+        int distance = std::abs(here.first - position.first) + std::abs(here.second - position.second);
+        if (distance <= radius) found.emplace_back(distance, here);
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+std::vector<std::pair<int,std::pair<int,int>>> withDistances(const std::vector<FeatureSite>& sites, std::pair<int,int> position){
+    std::vector<std::pair<int,std::pair<int,int>>> found;
+    for (auto& site : sites){
+        found.emplace_back(std::abs(site.coordinates.first - position.first) + std::abs(site.coordinates.second - position.second), site.coordinates);
+    }
+    return found;
+}
+
+TEST(FeatureIndex, MatchesBruteForce){
+    Board board(5);
+    board.generateRegion(std::make_pair(0,0), 60);
+
+    for (auto position : {std::make_pair(0,0), std::make_pair(37,-12), std::make_pair(-55,58), std::make_pair(200,0)}){
+        for (int feature : {(int)featGen.any, (int)featGen.city, (int)featGen.camp, (int)featGen.lake}){
+            auto expected = bruteForceFeatures(board, position, feature, 40);
+            EXPECT_EQ(withDistances(board.featuresWithin(position, feature, 40), position), expected);
+
+            auto nearest = withDistances(board.nearestFeatures(position, feature, 5, 40), position);
+            std::vector<std::pair<int,std::pair<int,int>>> expectedNearest(expected.begin(), expected.begin() + std::min<std::size_t>(5, expected.size()));
+            EXPECT_EQ(nearest, expectedNearest);
+        }
+    }
+    EXPECT_TRUE(board.nearestFeatures(std::make_pair(0,0), featGen.any, 0, 40).empty());
+    EXPECT_TRUE(board.featuresWithin(std::make_pair(0,0), featGen.any, -1).empty());
+}
+
+TEST(FeatureIndex, PathToFeatureMatchesPathTo){
+    Board board(5);
+    board.generateRegion(std::make_pair(0,0), 60);
+    SearchArena arena;
+
+    for (auto start : {std::make_pair(0,0), std::make_pair(20,-31), std::make_pair(-40,15)}){
+        for (int feature : {(int)featGen.any, (int)featGen.city, (int)featGen.village}){
+            for (bool ignoreTravelCost : {true, false}){
+                int maxDistance = ignoreTravelCost ? 40 : 200;
+                Path expected = board.pathTo(start, -1, feature, ignoreTravelCost, maxDistance, 0);
+                Path found = board.pathToFeature(arena, start, feature, ignoreTravelCost, maxDistance);
+                EXPECT_EQ(found.tilesTraversed == -1, expected.tilesTraversed == -1);
+                if (expected.tilesTraversed == -1) continue;
+
+                EXPECT_EQ(ignoreTravelCost ? found.tilesTraversed : found.travelCost, ignoreTravelCost ? expected.tilesTraversed : expected.travelCost);
+                int endFeature = board.getTile(found.steps.back()).getFeature();
+                EXPECT_TRUE(endFeature == feature || (feature == featGen.any && endFeature != featGen.none));
+            }
+        }
+    }
+}
+
+TEST(FeatureIndex, UpdatesWithChunks){
+    // Far from the region generated around the origin
+    Board board(5);
+    auto position = std::make_pair(790,790);
+    EXPECT_TRUE(board.nearestFeatures(position, featGen.any, 1, 100).empty());
+
+    Chunk chunk;
+    for (int i = 0; i < Chunk::area/2; i++) chunk.set(i, Tile(tileGen.plains));
+    Tile city(tileGen.plains);
+    city.setFeature(featGen.city);
+    chunk.set(ChunkMap::localIndex(std::make_pair(805,810)), city);
+    board.addChunk(std::make_pair(50,50), chunk);
+
+    auto found = board.nearestFeatures(position, featGen.city, 1, 100);
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0].coordinates, std::make_pair(805,810));
+    EXPECT_EQ(found[0].feature, (int)featGen.city);
+    EXPECT_TRUE(board.nearestFeatures(position, featGen.camp, 1, 100).empty());
+    EXPECT_TRUE(board.nearestFeatures(position, featGen.city, 1, 34).empty());
+
+    // Tiles merged into the chunk later are indexed too
+    Tile camp(tileGen.forest);
+    camp.setFeature(featGen.camp);
+    for (int i = Chunk::area/2; i < Chunk::area; i++) chunk.set(i, Tile(tileGen.plains));
+    chunk.set(ChunkMap::localIndex(std::make_pair(812,800)), camp);
+    board.addChunk(std::make_pair(50,50), chunk);
+    std::vector<std::pair<int,int>> expected = {{812,800}, {805,810}};
+    std::vector<std::pair<int,int>> coordinates;
+    for (auto& site : board.nearestFeatures(position, featGen.any, 5, 100)) coordinates.push_back(site.coordinates);
+    EXPECT_EQ(coordinates, expected);
+    EXPECT_EQ(board.featuresWithin(position, featGen.camp, 100).size(), 1);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "../src/flatmap.h"
+
+TEST(FlatMap, InsertFind){
+    FlatMap<int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(std::make_pair(0,0)), nullptr);
+
+    auto [first, firstInserted] = map.insert(std::make_pair(-3,7), 1);
+    EXPECT_TRUE(firstInserted);
+    EXPECT_EQ(*first, 1);
+    auto [again, againInserted] = map.insert(std::make_pair(-3,7), 2);
+    EXPECT_FALSE(againInserted);
+    EXPECT_EQ(*again, 1);
+
+    *map.find(std::make_pair(-3,7)) = 5;
+    EXPECT_EQ(*map.find(std::make_pair(-3,7)), 5);
+    EXPECT_FALSE(map.contains(std::make_pair(7,-3)));
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(FlatMap, GrowsAndIterates){
+    FlatMap<int> map(4);
+    EXPECT_EQ(map.capacity(), 4);
+    for (int x = -20; x < 20; x++){
+        for (int y = -20; y < 20; y++) map.insert(std::make_pair(x,y), x*100 + y);
+    }
+    EXPECT_EQ(map.size(), 1600);
+    EXPECT_GE(map.capacity(), 1600);
+    EXPECT_EQ(*map.find(std::make_pair(-20,19)), -1981);
+
+    std::set<std::pair<int,int>> seen;
+    map.forEach([&](std::pair<int,int> coordinates, int value){
+        EXPECT_EQ(value, coordinates.first*100 + coordinates.second);
+        seen.insert(coordinates);
+    });
+    EXPECT_EQ(seen.size(), 1600);
+}
+
+TEST(FlatMap, ClearKeepsCapacity){
+    FlatMap<int> map;
+    for (int i = 0; i < 1000; i++) map.insert(std::make_pair(i,-i), i);
+    std::size_t capacity = map.capacity();
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_FALSE(map.contains(std::make_pair(10,-10)));
+    int entries = 0;
+    map.forEach([&](std::pair<int,int>, int){entries++;});
+    EXPECT_EQ(entries, 0);
+
+    EXPECT_TRUE(map.insert(std::make_pair(10,-10), 3).second);
+    EXPECT_EQ(*map.find(std::make_pair(10,-10)), 3);
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(CoordinateKey, RoundTrip){
+    for (auto coordinates : {std::make_pair(0,0), std::make_pair(-1,1), std::make_pair(2147483647,-2147483647 - 1)}){
+        EXPECT_EQ(keyCoordinates(coordinateKey(coordinates)), coordinates);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "../src/board.h"
+#include "../src/flowfield.h"
+#include "../src/utility.h"
+
+TEST(FlowField, MatchesFindPath){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 20);
+    auto destination = std::make_pair(5,-3);
+
+    for (bool ignoreTravelCost : {true, false}){
+        FlowField field(board, destination, std::make_pair(0,0), 32, ignoreTravelCost);
+        for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), 31)){
+            if ((here.first + here.second) % 5 != 0) continue;
+            Path path = board.findPath(here, destination, ignoreTravelCost, 100000);
+            EXPECT_EQ(field.distance(here), ignoreTravelCost ? path.tilesTraversed : path.travelCost);
+        }
+        EXPECT_EQ(field.distance(destination), 0);
+        EXPECT_EQ(field.distance(std::make_pair(40,0)), -1);
+    }
+}
+
+TEST(FlowField, PathFrom){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 20);
+    auto destination = std::make_pair(5,-3);
+    FlowField field(board, destination, std::make_pair(0,0), 32);
+    auto start = destination;
+    for (auto& here : getCoordinatesInRing(destination, 15)){
+        if (field.distance(here) > 0) start = here;
+    }
+
+    Path path = field.pathFrom(board, start);
+    Path expected = board.findPath(start, destination, false, 100000);
+    ASSERT_NE(path.tilesTraversed, -1);
+    EXPECT_EQ(path.travelCost, expected.travelCost);
+    EXPECT_EQ(path.travelCost, field.distance(start));
+    EXPECT_EQ(path.steps.front(), field.nextStep(start));
+    EXPECT_EQ(path.steps.back(), destination);
+
+    auto previous = start;
+    for (auto& here : path.steps){
+        EXPECT_EQ(std::abs(here.first - previous.first) + std::abs(here.second - previous.second), 1);
+        previous = here;
+    }
+    EXPECT_EQ(field.nextStep(destination), destination);
+}
+
+TEST(FlowField, PatchesNewTiles){
+    Board board(7);
+    auto destination = std::make_pair(5,-3);
+    FlowField field(board, destination, std::make_pair(0,0), 40);
+    EXPECT_EQ(field.update(board), 0);
+
+    board.generateRegion(std::make_pair(0,0), 40);
+    EXPECT_GT(field.update(board), 0);
+    FlowField rebuilt(board, destination, std::make_pair(0,0), 40);
+
+    for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), 40)){
+        EXPECT_EQ(field.distance(here), rebuilt.distance(here));
+    }
+}
+
+TEST(FlowFieldCache, ReusesFields){
+    Board board(7);
+    FlowFieldCache cache;
+    const FlowField& first = cache.get(board, std::make_pair(5,-3), std::make_pair(0,0), 20);
+    const FlowField& second = cache.get(board, std::make_pair(5,-3), std::make_pair(0,0), 20);
+    cache.get(board, std::make_pair(5,-3), std::make_pair(0,0), 20, true);
+    cache.get(board, std::make_pair(-2,1), std::make_pair(0,0), 20);
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(cache.size(), 3);
+    cache.erase(std::make_pair(5,-3));
+    EXPECT_EQ(cache.size(), 1);
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
\ No newline at end of file
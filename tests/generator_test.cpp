@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../src/board.h"
+#include "../src/generator.h"
+#include "../src/global.h"
+#include "../src/utility.h"
+
+TEST(Generator, ChunkIndependentOfOrder){
+    Generator generator(7);
+    Chunk first = generator.generateChunk(std::make_pair(2,-3));
+    generator.generateChunk(std::make_pair(2,-2));
+    Chunk second = Generator(7).generateChunk(std::make_pair(2,-3));
+
+    EXPECT_EQ(first.count(), Chunk::area);
+    for (int i = 0; i < Chunk::area; i++){
+        EXPECT_EQ(first.tiles[i].getBiome(), second.tiles[i].getBiome());
+        EXPECT_EQ(first.tiles[i].getFeature(), second.tiles[i].getFeature());
+    }
+}
+
+TEST(Generator, ParallelMatchesSerial){
+    Board serial(11);
+    Board parallel(11);
+    serial.generateRegion(std::make_pair(0,0), 100, 1);
+    parallel.generateRegion(std::make_pair(0,0), 100, 4);
+
+    for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), 100)){
+        EXPECT_EQ(serial.getTile(here).getBiome(), parallel.getTile(here).getBiome());
+        EXPECT_EQ(serial.getTile(here).getFeature(), parallel.getTile(here).getFeature());
+    }
+}
+
+TEST(Generator, CityDistrictsNextToCity){
+    Board board(3);
+    board.generateRegion(std::make_pair(0,0), 200);
+
+    int districts = 0;
+    for (auto& here : getCoordinatesInRadius(std::make_pair(0,0), 199)){
+        int feature = board.getTile(here).getFeature();
+        if (feature < featGen.cityMarket || feature > featGen.cityNeighbourhood) continue;
+        districts++;
+        EXPECT_TRUE(board.getTile(here).isTravellable());
+
+        bool nextToCity = false;
+        for (auto& neighbour : getCoordinatesInRadius(here, 1)){
+            if (board.getTile(neighbour).getFeature() == featGen.city) nextToCity = true;
+        }
+        EXPECT_TRUE(nextToCity);
+    }
+    EXPECT_GT(districts, 0);
+}
+
+TEST(Generator, AllBiomesValid){
+    Chunk chunk = Generator(5).generateChunk(std::make_pair(-1,4));
+    for (auto& tile : chunk.tiles){
+        EXPECT_GE(tile.getBiome(), tileGen.plains);
+        EXPECT_LE(tile.getBiome(), tileGen.mountains);
+    }
+}
\ No newline at end of file
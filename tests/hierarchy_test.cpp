@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include "../src/board.h"
+#include "../src/hierarchy.h"
+#include "../src/utility.h"
+
+void expectValidPath(const Board& board, const Path& path, std::pair<int,int> start, std::pair<int,int> end, bool ignoreTravelCost){
+    ASSERT_EQ(path.steps.size(), path.tilesTraversed);
+    int travelCost = 0;
+    auto previous = start;
+    for (auto& here : path.steps){
+        EXPECT_EQ(std::abs(here.first - previous.first) + std::abs(here.second - previous.second), 1);
+        if (!ignoreTravelCost && here != end){
+            EXPECT_TRUE(board.getTile(here).isTravellable());
+        }
+        travelCost += board.getTile(here).getTravelCost();
+        previous = here;
+    }
+    EXPECT_EQ(previous, end);
+    EXPECT_EQ(path.travelCost, travelCost);
+}
+
+TEST(PathHierarchy, CloseToShortest){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 100);
+    auto start = std::make_pair(-90,-85);
+
+    for (bool ignoreTravelCost : {true, false}){
+        PathHierarchy hierarchy(ignoreTravelCost);
+        int found = 0;
+        for (auto& end : getCoordinatesInRing(std::make_pair(0,0), 90)){
+            if ((end.first + end.second) % 17 != 0) continue;
+            Path shortest = board.findPath(start, end, ignoreTravelCost, 1000000);
+            Path path = hierarchy.findPath(board, start, end);
+            if (shortest.tilesTraversed == -1){
+                EXPECT_EQ(path.tilesTraversed, -1);
+                continue;
+            }
+
+            ASSERT_NE(path.tilesTraversed, -1);
+            expectValidPath(board, path, start, end, ignoreTravelCost);
+            int cost = ignoreTravelCost ? path.tilesTraversed : path.travelCost;
+            int shortestCost = ignoreTravelCost ? shortest.tilesTraversed : shortest.travelCost;
+            EXPECT_GE(cost, shortestCost);
+            EXPECT_LE(cost, shortestCost*5/4);
+            found++;
+        }
+        EXPECT_GT(found, 0);
+        EXPECT_GT(hierarchy.size(), 0);
+    }
+}
+
+TEST(PathHierarchy, ShortRoutesAreShortest){
+    Board board(7);
+    auto start = std::make_pair(0,0);
+    PathHierarchy hierarchy;
+
+    for (auto& end : getCoordinatesInRadius(start, 8)){
+        Path shortest = board.findPath(start, end, false, 1000000);
+        Path path = hierarchy.findPath(board, start, end);
+        EXPECT_EQ(path.tilesTraversed, shortest.tilesTraversed);
+        EXPECT_EQ(path.travelCost, shortest.travelCost);
+    }
+    EXPECT_EQ(hierarchy.size(), 0);
+}
+
+TEST(PathHierarchy, RebuildsChangedChunks){
+    Board board(7);
+    PathHierarchy hierarchy;
+    auto start = std::make_pair(0,0);
+    auto end = std::make_pair(60,-60);
+
+    EXPECT_EQ(hierarchy.findPath(board, start, end).tilesTraversed, -1);
+
+    board.generateRegion(std::make_pair(30,-30), 40);
+    Path shortest = board.findPath(start, end, false, 1000000);
+    Path path = hierarchy.findPath(board, start, end);
+    ASSERT_EQ(path.tilesTraversed == -1, shortest.tilesTraversed == -1);
+    if (path.tilesTraversed != -1) expectValidPath(board, path, start, end, false);
+}
+
+TEST(PathHierarchy, CornerEntrance){
+    Board board(7);
+    // Only the corner tile of the middle chunk is passable, an entrance on both of its positive borders
+    Chunk blocked;
+    Chunk open;
+    for (int i = 0; i < Chunk::area; i++){
+        blocked.set(i, Tile(TileGen::mountains));
+        open.set(i, Tile(TileGen::plains));
+    }
+    Chunk corner = blocked;
+    corner.set(Chunk::area - 1, Tile(TileGen::plains));
+    board.addChunk(std::make_pair(40,40), corner);
+    board.addChunk(std::make_pair(41,40), open);
+    board.addChunk(std::make_pair(40,41), open);
+    board.addChunk(std::make_pair(41,41), blocked);
+
+    auto start = std::make_pair(670,641);
+    auto end = std::make_pair(641,670);
+    PathHierarchy hierarchy;
+    Path shortest = board.findPath(start, end, false, 1000000);
+    ASSERT_NE(shortest.tilesTraversed, -1);
+    Path path = hierarchy.findPath(board, start, end);
+    ASSERT_NE(path.tilesTraversed, -1);
+    expectValidPath(board, path, start, end, false);
+    EXPECT_NE(std::find(path.steps.begin(), path.steps.end(), std::make_pair(655,655)), path.steps.end());
+    EXPECT_EQ(path.travelCost, shortest.travelCost);
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../src/board.h"
+#include "../src/exceptions.h"
+#include "../src/global.h"
+#include "../src/interface.h"
+
+TEST(DrawFrame, FirstFrameWhole){
+    Board board(7);
+    Interface interface;
+    std::string frame = interface.drawFrame(board, std::make_pair(0,0), {"HP: 25"});
+    EXPECT_EQ(frame.rfind("\x1b[H\x1b[2J", 0), 0);
+    EXPECT_NE(frame.find("\u263A"), std::string::npos);
+    EXPECT_NE(frame.find("HP: 25"), std::string::npos);
+
+    // Clearing, one cursor move per row, the status row and its line erase, then one move below the frame
+    int side = board.getViewSize()/2*2 + 1;
+    std::size_t sequences = 0;
+    for (std::size_t at = frame.find("\x1b["); at != std::string::npos; at = frame.find("\x1b[", at + 1)) sequences++;
+    EXPECT_EQ(sequences, 2 + side + 2 + 1);
+}
+
+TEST(DrawFrame, OnlyChangesSent){
+    Board board(7);
+    Interface interface;
+    std::string first = interface.drawFrame(board, std::make_pair(0,0), {"HP: 25"});
+    EXPECT_TRUE(interface.drawFrame(board, std::make_pair(0,0), {"HP: 25"}).empty());
+
+    // A changed status row is all that is sent
+    std::string status = interface.drawFrame(board, std::make_pair(0,0), {"HP: 24"});
+    EXPECT_NE(status.find("HP: 24"), std::string::npos);
+    EXPECT_LT(status.size(), 40);
+
+    // Moving only sends the cells that differ
+    board.generateRegion(std::make_pair(1,0), board.getViewSize());
+    std::string moved = interface.drawFrame(board, std::make_pair(1,0), {"HP: 24"});
+    EXPECT_FALSE(moved.empty());
+    EXPECT_LT(moved.size(), first.size());
+    EXPECT_EQ(moved.find("\x1b[2J"), std::string::npos);
+}
+
+TEST(DrawFrame, MissingTile){
+    Board board(7);
+    Interface interface;
+    EXPECT_THROW(interface.drawFrame(board, std::make_pair(1000,1000), {}), TileMissingException);
+}
+
+TEST(StatusRows, OverflowDropped){
+    int capacity = statusRows.capacity();
+    Interface::takeStatusRows(capacity);
+
+    // Pushing past capacity drops rows instead of waiting for the interface to take some
+    int pushed = 0;
+    for (int row = 0; row < capacity + 10; row++) pushed += Interface::pushStatusRow(std::to_string(row));
+    EXPECT_EQ(pushed, capacity);
+
+    auto rows = Interface::takeStatusRows(capacity + 1);
+    for (int row = 0; row < capacity; row++) EXPECT_EQ(rows[row], std::to_string(row));
+    EXPECT_EQ(rows[capacity], "");
+    EXPECT_TRUE(Interface::pushStatusRow("after"));
+    EXPECT_EQ(Interface::takeStatusRows(1)[0], "after");
+}
\ No newline at end of file
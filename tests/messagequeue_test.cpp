@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/messagequeue.h"
+
+TEST(SpscQueue, OrderAndCapacity){
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_FALSE(queue.tryPop());
+
+    for (int i = 0; i < 4; i++) EXPECT_TRUE(queue.tryPush(int(i)));
+    EXPECT_FALSE(queue.tryPush(4));
+    for (int i = 0; i < 4; i++) EXPECT_EQ(queue.tryPop(), i);
+    EXPECT_FALSE(queue.tryPop());
+
+    // Indices keep wrapping around the ring
+    for (int i = 0; i < 10; i++){
+        EXPECT_TRUE(queue.tryPush(int(i)));
+        EXPECT_EQ(queue.pop(), i);
+    }
+}
+
+TEST(SpscQueue, MoveOnlyAndDrain){
+    SpscQueue<std::unique_ptr<int>> queue(8);
+    auto message = std::make_unique<int>(1);
+    EXPECT_TRUE(queue.tryPush(std::move(message)));
+    for (int i = 2; i <= 8; i++) queue.push(std::make_unique<int>(i));
+
+    // A failed push leaves the message with the caller
+    message = std::make_unique<int>(9);
+    EXPECT_FALSE(queue.tryPush(std::move(message)));
+    ASSERT_NE(message, nullptr);
+
+    std::vector<int> drained;
+    EXPECT_EQ(queue.drain([&](std::unique_ptr<int>&& popped){drained.push_back(*popped);}, 5), 5);
+    EXPECT_EQ(queue.drain([&](std::unique_ptr<int>&& popped){drained.push_back(*popped);}), 3);
+    EXPECT_EQ(drained, std::vector<int>({1,2,3,4,5,6,7,8}));
+}
+
+TEST(SpscQueue, AcrossThreads){
+    SpscQueue<int> queue(16);
+    int messages = 100000;
+    std::thread producer([&]{for (int i = 0; i < messages; i++) queue.push(int(i));});
+    for (int i = 0; i < messages; i++) ASSERT_EQ(queue.pop(), i);
+    producer.join();
+    EXPECT_FALSE(queue.tryPop());
+}
+
+TEST(MpscQueue, OrderAndCapacity){
+    MpscQueue<std::string> queue(4);
+    EXPECT_FALSE(queue.tryPop());
+    for (int i = 0; i < 4; i++) EXPECT_TRUE(queue.tryPush(std::to_string(i)));
+    EXPECT_FALSE(queue.tryPush("4"));
+    for (int i = 0; i < 4; i++) EXPECT_EQ(queue.tryPop(), std::to_string(i));
+    EXPECT_EQ(queue.tryPop().value_or(""), "");
+}
+
+TEST(MpscQueue, ManyProducers){
+    MpscQueue<std::pair<int,int>> queue(64);
+    int producers = 4;
+    int messages = 20000;
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producers; producer++){
+        threads.emplace_back([&, producer]{for (int i = 0; i < messages; i++) queue.push(std::make_pair(producer, i));});
+    }
+
+    // Every producer's messages arrive, each in the order it pushed them
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    auto receive = [&](std::pair<int,int>&& message){
+        EXPECT_EQ(message.second, next[message.first]++);
+        received++;
+    };
+    while (received < producers*messages){
+        receive(queue.pop());
+        queue.drain(receive);
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_FALSE(queue.tryPop());
+    for (int count : next) EXPECT_EQ(count, messages);
+}
\ No newline at end of file
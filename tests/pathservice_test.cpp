@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include "../src/board.h"
+#include "../src/global.h"
+#include "../src/pathservice.h"
+#include "../src/utility.h"
+
+std::vector<PathRequest> makeRequests(){
+    std::vector<PathRequest> requests;
+    for (auto& start : getCoordinatesInRadius(std::make_pair(0,0), 6)){
+        PathRequest request;
+        request.start = start;
+        request.feature = featGen.any;
+        requests.push_back(request);
+
+        request.feature = -1;
+        request.biome = tileGen.desert;
+        request.ignoreTravelCost = false;
+        request.maxDistance = 200;
+        requests.push_back(request);
+
+        request.biome = -1;
+        request.end = std::make_pair(-start.second, start.first);
+        requests.push_back(request);
+    }
+    return requests;
+}
+
+TEST(PathService, FuturesMatchPathTo){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 40);
+    auto requests = makeRequests();
+
+    PathService service(4);
+    auto futures = service.submit(PathService::snapshot(board), requests);
+    ASSERT_EQ(futures.size(), requests.size());
+
+    for (std::size_t i = 0; i < requests.size(); i++){
+        const PathRequest& request = requests[i];
+        Path expected = board.pathTo(request.start, request.biome, request.feature, request.ignoreTravelCost, request.maxDistance, request.toSkip, request.end);
+        Path path = futures[i].get();
+        EXPECT_EQ(path.tilesTraversed, expected.tilesTraversed);
+        EXPECT_EQ(path.travelCost, expected.travelCost);
+        EXPECT_EQ(path.steps, expected.steps);
+    }
+}
+
+TEST(PathService, CallbackWhileGenerating){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 40);
+    auto snapshot = PathService::snapshot(board);
+    auto requests = makeRequests();
+
+    std::vector<int> costs(requests.size(), -2);
+    std::mutex mutex;
+    std::atomic<int> completed = 0;
+    std::promise<void> done;
+    {
+        PathService service(4);
+        service.submit(snapshot, requests, [&](std::size_t index, const Path& path){
+            {
+                std::lock_guard lock(mutex);
+                costs[index] = path.travelCost;
+            }
+            if (++completed == (int)requests.size()) done.set_value();
+        });
+        board.generateRegion(std::make_pair(0,0), 120);
+        done.get_future().wait();
+    }
+
+    EXPECT_EQ(completed, requests.size());
+    for (std::size_t i = 0; i < requests.size(); i++){
+        const PathRequest& request = requests[i];
+        EXPECT_EQ(costs[i], snapshot->pathTo(request.start, request.biome, request.feature, request.ignoreTravelCost, request.maxDistance, request.toSkip, request.end).travelCost);
+    }
+}
+
+TEST(PathService, CallbackErrors){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 40);
+    auto requests = makeRequests();
+
+    std::atomic<int> completed = 0;
+    std::atomic<int> failed = 0;
+    std::promise<void> done;
+    auto finish = [&]{
+        if (completed + failed == (int)requests.size()) done.set_value();
+    };
+    {
+        // One worker runs every query of a task in turn, so a throw mustn't skip the ones after it
+        PathService service(1);
+        service.submit(PathService::snapshot(board), requests, [&](std::size_t index, const Path&){
+            if (index % 3 == 0) throw std::runtime_error("callback failed");
+            completed++;
+            finish();
+        }, [&](std::size_t index, std::exception_ptr error){
+            EXPECT_EQ(index % 3, 0);
+            EXPECT_THROW(std::rethrow_exception(error), std::runtime_error);
+            failed++;
+            finish();
+        });
+        done.get_future().wait();
+    }
+
+    EXPECT_EQ(failed, (int)(requests.size() + 2)/3);
+    EXPECT_EQ(completed + failed, (int)requests.size());
+}
\ No newline at end of file
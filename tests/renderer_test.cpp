@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/board.h"
+#include "../src/exceptions.h"
+#include "../src/renderer.h"
+
+TEST(Renderer, CoalescesToNewest){
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 60);
+    std::mutex mutex;
+    std::vector<std::string> frames;
+    int submitted = 50;
+    auto renderer = std::make_unique<Renderer>(Interface(), 20, [&](const std::string& frame){
+        std::lock_guard lock(mutex);
+        frames.push_back(frame);
+    });
+    for (int i = 0; i < submitted; i++){
+        renderer->submit(ViewSnapshot::capture(board, std::make_pair(i % 20, 0), {"frame " + std::to_string(i)}));
+    }
+    // Snapshots of no view are ignored
+    renderer->submit(ViewSnapshot());
+
+    // The newest snapshot is drawn before the renderer stops
+    int dropped = renderer->framesDropped();
+    renderer.reset();
+    EXPECT_GE(frames.size(), 1);
+    EXPECT_LT(frames.size(), submitted);
+    EXPECT_EQ(frames.size() + dropped, submitted);
+    EXPECT_NE(frames.back().find("frame 49"), std::string::npos);
+}
+
+TEST(Renderer, PacedToFrameRate){
+    Board board(7);
+    Renderer renderer(Interface(), 10, [](const std::string&){});
+    int submitted = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(350)){
+        renderer.submit(ViewSnapshot::capture(board, std::make_pair(0,0), {"frame " + std::to_string(submitted++)}));
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    // One frame straight away, then one every 100ms
+    EXPECT_GE(renderer.framesDrawn(), 3);
+    EXPECT_LE(renderer.framesDrawn(), 6);
+    EXPECT_EQ(renderer.framesDrawn() + renderer.framesDropped(), submitted);
+}
+
+TEST(Renderer, ReportsDrawErrors){
+    Renderer renderer(Interface(), 100, [](const std::string&){});
+    ViewSnapshot view;
+    view.side = 1;
+    view.tiles.resize(1);
+    // A tile with a biome that doesn't exist
+    std::uint8_t invalid = TileGen::biomeCount;
+    std::memcpy(&view.tiles[0], &invalid, 1);
+    renderer.submit(view);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_THROW(renderer.submit(view), InvalidBiomeFound);
+    EXPECT_EQ(renderer.framesDrawn(), 0);
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <map>
+#include "../src/board.h"
+#include "../src/rng.h"
+#include "../src/utility.h"
+
+TEST(Rng, SameRegionSameStream){
+    Rng first(7, std::make_pair(-4,12));
+    Rng second(7, std::make_pair(-4,12));
+    for (int i = 0; i < 100; i++) EXPECT_EQ(first.next(), second.next());
+}
+
+TEST(Rng, RegionsDiffer){
+    Rng here(7, std::make_pair(3,5));
+    Rng mirrored(7, std::make_pair(5,3));
+    Rng reseeded(8, std::make_pair(3,5));
+    std::uint64_t value = here.next();
+    EXPECT_NE(value, mirrored.next());
+    EXPECT_NE(value, reseeded.next());
+}
+
+TEST(Rng, RandIntInclusiveRange){
+    Rng rng(1);
+    std::map<int,int> counts;
+    for (int i = 0; i < 10000; i++){
+        int value = rng.randInt(2,5);
+        EXPECT_GE(value, 2);
+        EXPECT_LE(value, 5);
+        counts[value]++;
+    }
+    EXPECT_EQ(counts.size(), 4);
+    EXPECT_EQ(rng.randInt(3,3), 3);
+}
+
+TEST(Rng, PickByProbability){
+    Rng rng(1);
+    ChanceTable<2> chances{{{{1,0.25},{2,0.75}}}};
+    int ones = 0;
+    for (int i = 0; i < 10000; i++){
+        int key = rng.pickByProbability(chances);
+        EXPECT_TRUE(key == 1 || key == 2);
+        if (key == 1) ones++;
+    }
+    EXPECT_NEAR(ones, 2500, 250);
+    EXPECT_FALSE(rng.pickValue(0));
+    EXPECT_TRUE(rng.pickValue(1));
+}
+
+TEST(ChanceTable, Cumulative){
+    constexpr ChanceTable<3> table{{{{4,1.0},{7,2.0},{9,1.0}}}};
+    static_assert(table.cumulative[2] == 4.0);
+    static_assert(table.pick(0.0) == 4);
+    static_assert(table.pick(0.25) == 7);
+    static_assert(table.pick(0.99) == 9);
+    EXPECT_EQ(table.pick(0.74), 7);
+}
+
+TEST(Rng, BoardGenerationDeterministic){
+    Board first(7);
+    rand();
+    Board second(7);
+
+    auto coordinatesToCheck = getCoordinatesInRadius(std::make_pair(0,0), first.getViewSize()/2);
+    for (auto& here : coordinatesToCheck){
+        EXPECT_EQ(first.getTile(here).getBiome(), second.getTile(here).getBiome());
+        EXPECT_EQ(first.getTile(here).getFeature(), second.getTile(here).getFeature());
+    }
+}
\ No newline at end of file
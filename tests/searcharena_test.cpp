@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "../src/searcharena.h"
+
+TEST(SearchArena, InsertFind){
+    SearchArena arena;
+    auto [first, firstInserted] = arena.insert(SearchArena::Node{std::make_pair(0,0), -1, 0, 0});
+    auto [second, secondInserted] = arena.insert(SearchArena::Node{std::make_pair(-1,0), first, 1, 3});
+    auto [again, againInserted] = arena.insert(SearchArena::Node{std::make_pair(-1,0), first, 5, 5});
+
+    EXPECT_TRUE(firstInserted);
+    EXPECT_TRUE(secondInserted);
+    EXPECT_FALSE(againInserted);
+    EXPECT_EQ(again, second);
+    EXPECT_EQ(arena.size(), 2);
+    EXPECT_EQ(arena.find(std::make_pair(-1,0)), second);
+    EXPECT_EQ(arena.node(second).travelCost, 3);
+    EXPECT_EQ(arena.find(std::make_pair(0,-1)), -1);
+}
+
+TEST(SearchArena, ClearForgetsNodes){
+    SearchArena arena;
+    for (int x = -50; x < 50; x++){
+        for (int y = -50; y < 50; y++) arena.insert(SearchArena::Node{std::make_pair(x,y), -1, 0, 0});
+    }
+    EXPECT_EQ(arena.size(), 10000);
+    EXPECT_EQ(arena.find(std::make_pair(49,-50)), 9900);
+
+    arena.clear();
+    EXPECT_EQ(arena.size(), 0);
+    EXPECT_EQ(arena.find(std::make_pair(49,-50)), -1);
+    EXPECT_TRUE(arena.insert(SearchArena::Node{std::make_pair(49,-50), -1, 0, 0}).second);
+}
+
+TEST(SearchArena, HeapOrder){
+    SearchArena arena;
+    arena.push(5, 0, 0);
+    arena.push(3, 1, 1);
+    arena.push(3, 2, 2);
+    arena.push(4, 0, 3);
+
+    std::vector<int> order;
+    while (!arena.heapEmpty()) order.push_back(std::get<2>(arena.pop()));
+    EXPECT_EQ(order, std::vector<int>({2, 1, 3, 0}));
+}
+
+TEST(SearchArena, FifoOrder){
+    SearchArena arena;
+    arena.enqueue(2);
+    arena.enqueue(0);
+    EXPECT_EQ(arena.dequeue(), 2);
+    arena.enqueue(1);
+    EXPECT_EQ(arena.dequeue(), 0);
+    EXPECT_EQ(arena.dequeue(), 1);
+    EXPECT_TRUE(arena.fifoEmpty());
+}
+
+TEST(SearchArena, FinishFollowsParents){
+    SearchArena arena;
+    arena.insert(SearchArena::Node{std::make_pair(0,0), -1, 0, 0});
+    arena.insert(SearchArena::Node{std::make_pair(0,1), 0, 1, 2});
+    arena.insert(SearchArena::Node{std::make_pair(5,5), 0, 1, 1});
+    arena.insert(SearchArena::Node{std::make_pair(1,1), 1, 2, 4});
+
+    const Path& path = arena.finish(3);
+    EXPECT_EQ(path.tilesTraversed, 2);
+    EXPECT_EQ(path.travelCost, 4);
+    std::vector<std::pair<int,int>> expectedSteps = {std::make_pair(0,1), std::make_pair(1,1)};
+    EXPECT_EQ(path.steps, expectedSteps);
+
+    const Path& none = arena.fail();
+    EXPECT_EQ(none.tilesTraversed, -1);
+    EXPECT_EQ(none.travelCost, -1);
+    EXPECT_TRUE(none.steps.empty());
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "../src/board.h"
+#include "../src/generator.h"
+#include "../src/streamer.h"
+#include "../src/utility.h"
+
+TEST(Streamer, WaitForRegion){
+    Board board(5);
+    Streamer streamer(board);
+    auto center = std::make_pair(200,-150);
+
+    EXPECT_FALSE(board.regionReady(center, 20));
+    streamer.waitFor(board, center, 20);
+    EXPECT_TRUE(board.regionReady(center, 20));
+
+    Chunk expected = Generator(board.getSeed()).generateChunk(ChunkMap::chunkCoordinates(center));
+    auto here = ChunkMap::tileCoordinates(ChunkMap::chunkCoordinates(center), 37);
+    EXPECT_EQ(board.getTile(here).getBiome(), expected.tiles[37].getBiome());
+    EXPECT_EQ(board.getTile(here).getFeature(), expected.tiles[37].getFeature());
+}
+
+TEST(Streamer, FollowGeneratesAheadFirst){
+    Board board(5);
+    Streamer streamer(board, 1);
+    auto position = std::make_pair(1000,1000);
+    auto playerChunk = ChunkMap::chunkCoordinates(position);
+
+    std::vector<std::pair<int,int>> order;
+    streamer.setOnChunkReady([&order](std::pair<int,int> chunkCoordinates){order.push_back(chunkCoordinates);});
+    streamer.follow(board, position, std::make_pair(1,0));
+    streamer.waitForAll(board);
+
+    ASSERT_FALSE(order.empty());
+    EXPECT_EQ(order.front(), playerChunk);
+    EXPECT_TRUE(board.chunkGenerated(std::make_pair(playerChunk.first + 2, playerChunk.second)));
+    EXPECT_TRUE(board.chunkGenerated(std::make_pair(playerChunk.first - 1, playerChunk.second)));
+    EXPECT_FALSE(board.chunkGenerated(std::make_pair(playerChunk.first - 2, playerChunk.second)));
+}
+
+TEST(Streamer, Cancel){
+    Board board(5);
+    Streamer streamer(board, 8);
+    streamer.follow(board, std::make_pair(-5000,0));
+    streamer.cancel();
+    EXPECT_EQ(streamer.pending(), 0);
+}
+
+TEST(Streamer, RequestMovesQueuedChunkForward){
+    Board board(5);
+    Streamer streamer(board, 8);
+    auto position = std::make_pair(-3000,3000);
+    auto playerChunk = ChunkMap::chunkCoordinates(position);
+    auto corner = std::make_pair(playerChunk.first + 8, playerChunk.second + 8);
+
+    std::vector<std::pair<int,int>> order;
+    streamer.setOnChunkReady([&order](std::pair<int,int> chunkCoordinates){order.push_back(chunkCoordinates);});
+    // The corner is the last chunk follow queues, asking for it must still put it ahead of the rest
+    streamer.follow(board, position);
+    auto here = ChunkMap::tileCoordinates(corner, 0);
+    streamer.waitFor(board, here, 0);
+    EXPECT_TRUE(board.chunkGenerated(corner));
+    auto found = std::find(order.begin(), order.end(), corner);
+    ASSERT_NE(found, order.end());
+    EXPECT_LT(found - order.begin(), 20);
+}
\ No newline at end of file
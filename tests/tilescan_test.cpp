@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "../src/board.h"
+#include "../src/global.h"
+#include "../src/tilescan.h"
+#include "../src/utility.h"
+
+Chunk randomChunk(unsigned seed){
+    std::mt19937 engine(seed);
+    Chunk chunk;
+    for (int i = 0; i < Chunk::area; i++){
+        if (engine() % 8 == 0) continue;
+        Tile tile(engine() % TileGen::biomeCount);
+        tile.setFeature(engine() % 3 == 0 ? (int)(engine() % FeatureGen::featureCount) : (int)featGen.none);
+        tile.setReady(engine() % 4 != 0);
+        chunk.set(i, tile);
+    }
+    return chunk;
+}
+
+TEST(TileScan, KernelsMatchTiles){
+    std::vector<TilePattern> patterns = {TilePattern::ready(), TilePattern::matching(-1, -1), TilePattern::matching(-1, featGen.any)};
+    for (int biome = 0; biome < TileGen::biomeCount; biome++) patterns.push_back(TilePattern::matching(biome, -1));
+    for (int feature = featGen.none; feature < FeatureGen::featureCount; feature++) patterns.push_back(TilePattern::matching(tileGen.ocean, feature));
+
+    for (unsigned seed = 0; seed < 10; seed++){
+        Chunk chunk = randomChunk(seed);
+        for (auto& pattern : patterns){
+            ChunkMask expected{};
+            for (int i = 0; i < Chunk::area; i++){
+                if (chunk.contains(i) && ((reinterpret_cast<const std::uint8_t&>(chunk.tiles[i]) & pattern.mask) == pattern.value) != pattern.invert){
+                    expected[i/64] |= std::uint64_t(1) << (i%64);
+                }
+            }
+            for (auto kernel : {ScanKernel::scalar, ScanKernel::sse2, ScanKernel::avx2}){
+                if (scanKernelSupported(kernel)){
+                    EXPECT_EQ(scanChunk(chunk, pattern, kernel), expected);
+                }
+            }
+        }
+    }
+    EXPECT_TRUE(scanKernelSupported(bestScanKernel()));
+}
+
+TEST(TileScan, RectangleMask){
+    // Chunk (1,-1) holds x from 16 to 31 and y from -16 to -1
+    ChunkMask inside = rectangleMask(std::make_pair(1,-1), std::make_pair(30,-3), std::make_pair(40,5));
+    EXPECT_EQ(countMask(inside), 2*3);
+    std::vector<std::pair<int,int>> tiles;
+    forEachInMask(inside, [&](int index){tiles.push_back(ChunkMap::tileCoordinates(std::make_pair(1,-1), index));});
+    std::vector<std::pair<int,int>> expected = {{30,-3}, {30,-2}, {30,-1}, {31,-3}, {31,-2}, {31,-1}};
+    EXPECT_EQ(tiles, expected);
+
+    EXPECT_EQ(countMask(rectangleMask(std::make_pair(0,0), std::make_pair(-5,-5), std::make_pair(20,20))), Chunk::area);
+    EXPECT_EQ(countMask(rectangleMask(std::make_pair(0,0), std::make_pair(16,0), std::make_pair(20,20))), 0);
+}
+
+TEST(TileScan, BoardRegionQueries){
+    Board board(5);
+    board.generateRegion(std::make_pair(0,0), 40);
+    auto center = std::make_pair(3,-7);
+    int radius = 30;
+
+    for (auto [biome, feature] : {std::make_pair((int)tileGen.forest, -1), std::make_pair(-1, (int)featGen.any), std::make_pair(-1, (int)featGen.camp), std::make_pair(-1, -1)}){
+        std::vector<std::pair<int,int>> expected;
+        for (auto& here : getCoordinatesInRadius(center, radius)){
+            const Chunk* chunk = board.getChunk(ChunkMap::chunkCoordinates(here));
+            if (chunk == nullptr || !chunk->contains(ChunkMap::localIndex(here))) continue;
+            Tile tile = chunk->tiles[ChunkMap::localIndex(here)];
+            bool matches = feature != -1 ? tile.getFeature() == feature || (feature == featGen.any && tile.getFeature() != featGen.none) : tile.getBiome() == biome;
+            if (matches) expected.push_back(here);
+        }
+        auto found = board.findTiles(center, radius, biome, feature);
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(found, expected);
+        EXPECT_EQ(board.countTiles(center, radius, biome, feature), (int)expected.size());
+    }
+
+    EXPECT_TRUE(board.regionExists(center, radius));
+    EXPECT_TRUE(board.regionReady(center, radius));
+    EXPECT_FALSE(board.regionExists(center, 60));
+    EXPECT_FALSE(board.regionReady(center, 60));
+    EXPECT_EQ(board.countTiles(std::make_pair(500,500), 3, tileGen.forest, -1), 0);
+}
\ No newline at end of file
@@ -1,7 +1,39 @@
 #include <gtest/gtest.h>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include "../src/board.h"
+#include "../src/exceptions.h"
+#include "../src/generator.h"
 #include "../src/utility.h"
+#include "../src/worldfile.h"
+
+TEST(Coordinates, Ranges){
+    std::vector<std::pair<int,int>> square;
+    for (auto& here : getCoordinatesInRadius(std::make_pair(5,-5), 1)) square.push_back(here);
+    std::vector<std::pair<int,int>> expectedSquare = {{4,-6},{4,-5},{4,-4},{5,-6},{5,-5},{5,-4},{6,-6},{6,-5},{6,-4}};
+    EXPECT_EQ(square, expectedSquare);
+    EXPECT_EQ(getCoordinatesInRadius(std::make_pair(5,-5), 1).size(), 9);
+
+    std::vector<std::pair<int,int>> ring;
+    for (auto& here : getCoordinatesInRing(std::make_pair(0,0), 2)) ring.push_back(here);
+    EXPECT_EQ(ring.size(), getCoordinatesInRing(std::make_pair(0,0), 2).size());
+    std::vector<std::pair<int,int>> expectedRing = {{-2,-2},{-2,-1},{-2,0},{-2,1},{-2,2},{-1,-2},{-1,2},{0,-2},{0,2},{1,-2},{1,2},{2,-2},{2,-1},{2,0},{2,1},{2,2}};
+    EXPECT_EQ(ring, expectedRing);
+
+    auto centre = getCoordinatesInRing(std::make_pair(3,3), 0);
+    std::vector<std::pair<int,int>> centreCoordinates(centre.begin(), centre.end());
+    ASSERT_EQ(centreCoordinates.size(), 1);
+    EXPECT_EQ(centreCoordinates[0], std::make_pair(3,3));
+    auto empty = getCoordinatesInRadius(std::make_pair(3,3), -1);
+    EXPECT_EQ(empty.begin(), empty.end());
+    EXPECT_EQ(empty.size(), 0);
+
+    auto adjacent = getAdjacentCoordinates(std::make_pair(0,0));
+    EXPECT_EQ(adjacent[0], std::make_pair(-1,0));
+    EXPECT_EQ(adjacent[3], std::make_pair(1,0));
+}
 
 TEST(SaveLoad, SaveLoadJSON){
     auto position = std::make_pair(0,0);
@@ -41,4 +73,295 @@ TEST(SaveLoad, SaveLoadBIN){
 
     filename.append(".save");
     std::remove(filename.c_str());
+}
+
+int countChunks(const Board& board){
+    int chunks = 0;
+    board.forEachChunk([&](std::pair<int,int>, const Chunk&){chunks++;});
+    return chunks;
+}
+
+TEST(WorldFile, EncodeDecode){
+    Chunk chunk;
+    for (int i = 0; i < Chunk::area; i += 3){
+        Tile tile(i % 5);
+        tile.setFeature((i/7) % 14);
+        tile.setReady(i % 2);
+        chunk.set(i, tile);
+    }
+
+    Chunk decoded = WorldFile::decode(WorldFile::encode(chunk));
+    EXPECT_EQ(decoded.present, chunk.present);
+    for (int i = 0; i < Chunk::area; i += 3){
+        EXPECT_EQ(decoded.tiles[i].getBiome(), chunk.tiles[i].getBiome());
+        EXPECT_EQ(decoded.tiles[i].getFeature(), chunk.tiles[i].getFeature());
+        EXPECT_EQ(decoded.tiles[i].isReady(), chunk.tiles[i].isReady());
+    }
+    EXPECT_THROW(WorldFile::decode("damaged"), InvalidWorldFile);
+}
+
+TEST(WorldFile, EncodeRuns){
+    // A full chunk of one tile is a flags byte and a one entry palette
+    Chunk chunk;
+    for (int i = 0; i < Chunk::area; i++) chunk.set(i, Tile(TileGen::forest));
+    EXPECT_EQ(WorldFile::encode(chunk).size(), 3);
+
+    // Two splotches take two runs
+    for (int i = 100; i < Chunk::area; i++) chunk.set(i, Tile(TileGen::ocean));
+    chunk.tiles[7].setFeature(FeatureGen::cave);
+    std::string blob = WorldFile::encode(chunk);
+    EXPECT_LE(blob.size(), 12);
+    Chunk decoded = WorldFile::decode(blob);
+    EXPECT_EQ(decoded.count(), Chunk::area);
+    for (int i = 0; i < Chunk::area; i++){
+        EXPECT_EQ(decoded.tiles[i].getBiome(), chunk.tiles[i].getBiome());
+        EXPECT_EQ(decoded.tiles[i].getFeature(), chunk.tiles[i].getFeature());
+    }
+
+    // Blobs cut short or with a run past the end of the chunk are rejected
+    EXPECT_THROW(WorldFile::decode(blob.substr(0, blob.size() - 1)), InvalidWorldFile);
+    std::string overrun = blob;
+    overrun.back() = char(0x7f);
+    EXPECT_THROW(WorldFile::decode(overrun), InvalidWorldFile);
+}
+
+TEST(WorldFile, RejectsOtherVersions){
+    std::string filename = "version.save";
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 20);
+    WorldFile::write(board, filename);
+    EXPECT_EQ(WorldFile(filename).getSeed(), 7);
+
+    // Only the version written is read, older or newer files are refused
+    for (std::uint32_t version : {std::uint32_t(1), WorldFile::version - 1, WorldFile::version + 1}){
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(4);
+        for (int i = 0; i < 4; i++) file.put(char((version >> (8*i)) & 0xff));
+        file.close();
+        EXPECT_THROW(WorldFile worldFile(filename), InvalidWorldFile);
+    }
+
+    std::remove(filename.c_str());
+}
+
+TEST(SaveLoad, ResaveJSON){
+    auto position = std::make_pair(480,480);
+    std::string filename = "saveloadresavejson";
+
+    // A board without the starting chunks, so the chunk at 0,0 can differ from the generator
+    Board empty(7);
+    save(empty, filename);
+    Board toSave(std::make_shared<WorldFile>(filename + ".save"), position);
+    Chunk custom;
+    for (int i = 0; i < Chunk::area; i++) custom.set(i, Tile(TileGen::desert));
+    toSave.addChunk(std::make_pair(0,0), custom);
+    save(toSave, filename, true);
+
+    // Every chunk of a JSON export is kept by a delta save, none is left to be generated again
+    Board fromJson = load(filename, position, true);
+    EXPECT_FALSE(fromJson.chunkPristine(std::make_pair(0,0)));
+    save(fromJson, filename);
+    Board toLoad = load(filename, position);
+    toLoad.generateRegion(std::make_pair(0,0), 10);
+    for (auto& here : getCoordinatesInRadius(std::make_pair(8,8), 7)){
+        EXPECT_EQ(toLoad.getTile(here).getBiome(), TileGen::desert);
+    }
+    for (auto& here : getCoordinatesInRadius(position, toLoad.getViewSize()/2)){
+        EXPECT_EQ(toLoad.getTile(here).getBiome(), fromJson.getTile(here).getBiome());
+        EXPECT_EQ(toLoad.getTile(here).getFeature(), fromJson.getTile(here).getFeature());
+    }
+
+    std::remove((filename + ".save").c_str());
+    std::remove((filename + ".save.json").c_str());
+}
+
+TEST(SaveLoad, LazyLoad){
+    auto position = std::make_pair(0,0);
+    std::string filename = "saveloadlazy";
+    Board toSave(7);
+    toSave.generateRegion(position, 100);
+
+    // A chunk that differs from what the seed generates, so paging in can be told apart from generating
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    toSave.addChunk(std::make_pair(20,20), custom);
+    save(toSave, filename);
+
+    Board toLoad = load(filename, position);
+    EXPECT_EQ(toLoad.getSeed(), toSave.getSeed());
+    EXPECT_LT(countChunks(toLoad), countChunks(toSave));
+
+    toLoad.generateRegion(std::make_pair(80,-90), 10);
+    for (auto& here : getCoordinatesInRadius(std::make_pair(80,-90), 10)){
+        EXPECT_EQ(toLoad.getTile(here).getBiome(), toSave.getTile(here).getBiome());
+        EXPECT_EQ(toLoad.getTile(here).getFeature(), toSave.getTile(here).getFeature());
+    }
+
+    toLoad.generateRegion(std::make_pair(320,320), 0);
+    EXPECT_EQ(toLoad.getTile(std::make_pair(320,320)).getBiome(), TileGen::desert);
+    EXPECT_EQ(toLoad.getChunk(std::make_pair(20,20))->count(), Chunk::area);
+
+    filename.append(".save");
+    std::remove(filename.c_str());
+}
+
+TEST(SaveLoad, ResaveLazyLoad){
+    auto position = std::make_pair(0,0);
+    std::string filename = "saveloadresave";
+    Board toSave(7);
+    toSave.generateRegion(position, 60);
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    toSave.addChunk(std::make_pair(-10,10), custom);
+    save(toSave, filename);
+
+    // Saving over the file the board is paging from keeps the chunks never paged in
+    Board toResave = load(filename, position);
+    toResave.generateRegion(std::make_pair(0,100), 10);
+    save(toResave, filename);
+
+    Board toLoad = load(filename, position);
+    ASSERT_NE(toLoad.getSource(), nullptr);
+    EXPECT_EQ(toLoad.getSource()->size(), 1);
+    toLoad.generateRegion(std::make_pair(-160,160), 0);
+    EXPECT_EQ(toLoad.getTile(std::make_pair(-160,160)).getBiome(), TileGen::desert);
+    toLoad.generateRegion(std::make_pair(-60,60), 0);
+    EXPECT_EQ(toLoad.getTile(std::make_pair(-60,60)).getBiome(), toSave.getTile(std::make_pair(-60,60)).getBiome());
+
+    filename.append(".save");
+    std::remove(filename.c_str());
+}
+
+TEST(SaveLoad, MappedLoad){
+    auto position = std::make_pair(0,0);
+    std::string filename = "saveloadmapped.save";
+    Board toSave(7);
+    toSave.generateRegion(position, 60);
+    WorldFile::write(toSave, filename, WorldFile::Layout::mapped);
+
+    Board toLoad = load("saveloadmapped", position);
+    auto source = toLoad.getSource();
+    ASSERT_NE(source, nullptr);
+    EXPECT_EQ(source->getLayout(), WorldFile::Layout::mapped);
+    EXPECT_EQ(source->size(), countChunks(toSave));
+    EXPECT_FALSE(source->contains(std::make_pair(100,100)));
+
+    // Chunks are used in place from the mapping
+    auto chunkCoordinates = std::make_pair(1,-2);
+    toLoad.generateRegion(std::make_pair(20,-30), 5);
+    EXPECT_EQ(toLoad.getChunk(chunkCoordinates), source->findChunk(chunkCoordinates));
+    for (auto& here : getCoordinatesInRadius(std::make_pair(20,-30), 5)){
+        EXPECT_EQ(toLoad.getTile(here).getBiome(), toSave.getTile(here).getBiome());
+        EXPECT_EQ(toLoad.getTile(here).getFeature(), toSave.getTile(here).getFeature());
+    }
+
+    // Changing a chunk copies it out of the mapping first
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    toLoad.addChunk(chunkCoordinates, custom);
+    EXPECT_NE(toLoad.getChunk(chunkCoordinates), source->findChunk(chunkCoordinates));
+    EXPECT_EQ(source->findChunk(chunkCoordinates)->count(), toSave.getChunk(chunkCoordinates)->count());
+
+    // Nothing differs from the generator (tiles that exist are kept), so resaving over the mapped file keeps only the seed
+    save(toLoad, "saveloadmapped");
+    Board reloaded = load("saveloadmapped", position);
+    EXPECT_EQ(reloaded.getSource()->getLayout(), WorldFile::Layout::delta);
+    EXPECT_EQ(reloaded.getSource()->size(), 0);
+    reloaded.generateRegion(std::make_pair(-50,40), 0);
+    EXPECT_EQ(reloaded.getTile(std::make_pair(-50,40)).getBiome(), toSave.getTile(std::make_pair(-50,40)).getBiome());
+
+    std::remove(filename.c_str());
+}
+
+TEST(WorldFile, DeltaLayout){
+    std::string filename = "delta.save";
+    Board board(7);
+    board.generateRegion(std::make_pair(0,0), 60);
+    Chunk custom;
+    custom.set(0, Tile(TileGen::desert));
+    board.addChunk(std::make_pair(30,30), custom);
+    WorldFile::write(board, "packed.save");
+    WorldFile::write(board, filename, WorldFile::Layout::delta);
+    EXPECT_LT(std::filesystem::file_size(filename), std::filesystem::file_size("packed.save") / 10);
+
+    Chunk generated = Generator(7).generateChunk(std::make_pair(30,30));
+    {
+        WorldFile file(filename);
+        EXPECT_EQ(file.getLayout(), WorldFile::Layout::delta);
+        EXPECT_EQ(file.size(), 1);
+
+        // Stored tiles are laid over the generated chunk
+        Chunk chunk;
+        ASSERT_TRUE(file.read(std::make_pair(30,30), chunk));
+        EXPECT_EQ(chunk.count(), Chunk::area);
+        EXPECT_EQ(chunk.tiles[0].getBiome(), TileGen::desert);
+        EXPECT_FALSE(chunk.tiles[0].isReady());
+        EXPECT_EQ(std::memcmp(&chunk.tiles[1], &generated.tiles[1], sizeof(Tile)), 0);
+
+        // Generated chunks aren't journaled, unless they replace a stored chunk
+        file.append({{std::make_pair(31,30), Generator(7).generateChunk(std::make_pair(31,30))}});
+        EXPECT_FALSE(file.contains(std::make_pair(31,30)));
+        file.append({{std::make_pair(30,30), generated}});
+        ASSERT_TRUE(file.read(std::make_pair(30,30), chunk));
+        EXPECT_TRUE(chunk.tiles[0].isReady());
+    }
+
+    WorldFile::compact(filename);
+    EXPECT_EQ(WorldFile(filename).size(), 0);
+
+    std::remove(filename.c_str());
+    std::remove("packed.save");
+}
+
+TEST(WorldFile, JournalReplay){
+    std::string filename = "journal.save";
+    Board board(7);
+    WorldFile::write(board, filename);
+
+    Chunk first;
+    first.set(0, Tile(TileGen::desert));
+    Chunk second;
+    second.set(1, Tile(TileGen::ocean));
+    Chunk third;
+    third.set(2, Tile(TileGen::forest));
+    {
+        WorldFile file(filename);
+        file.append({{std::make_pair(50,50), first}});
+        file.append({{std::make_pair(51,50), second}});
+        EXPECT_EQ(file.size(), countChunks(board) + 2);
+    }
+
+    // A record torn by a crash is dropped, and written over by the next append
+    auto journalSize = std::filesystem::file_size(filename + ".journal");
+    std::filesystem::resize_file(filename + ".journal", journalSize - 5);
+    {
+        WorldFile file(filename);
+        EXPECT_TRUE(file.contains(std::make_pair(50,50)));
+        EXPECT_FALSE(file.contains(std::make_pair(51,50)));
+        file.append({{std::make_pair(52,50), third}});
+    }
+    {
+        WorldFile file(filename);
+        Chunk chunk;
+        ASSERT_TRUE(file.read(std::make_pair(52,50), chunk));
+        EXPECT_EQ(chunk.tiles[2].getBiome(), TileGen::forest);
+        ASSERT_TRUE(file.read(std::make_pair(50,50), chunk));
+        EXPECT_EQ(chunk.tiles[0].getBiome(), TileGen::desert);
+        EXPECT_EQ(file.size(), countChunks(board) + 2);
+    }
+
+    // Writing the file again leaves any old journal behind
+    std::filesystem::copy_file(filename + ".journal", "journal.old");
+    WorldFile::compact(filename);
+    EXPECT_FALSE(std::filesystem::exists(filename + ".journal"));
+    std::filesystem::rename("journal.old", filename + ".journal");
+    WorldFile::write(board, filename);
+    {
+        WorldFile file(filename);
+        EXPECT_FALSE(file.contains(std::make_pair(50,50)));
+        EXPECT_EQ(file.size(), countChunks(board));
+    }
+
+    std::remove(filename.c_str());
+    std::remove((filename + ".journal").c_str());
 }
\ No newline at end of file